@@ -0,0 +1,58 @@
+# Message shapes used by the benchmarks in benchmarks.jl
+
+struct Flat {
+    1: bool bool_val,
+    2: i8 byte_val,
+    3: i16 i16_val,
+    4: i32 i32_val,
+    5: i64 i64_val,
+    6: double double_val,
+    7: string string_val
+}
+
+struct Leaf {
+    1: i32 id,
+    2: Flat flat
+}
+
+struct Branch {
+    1: Leaf leaf,
+    2: list<Leaf> leaves
+}
+
+struct Nested {
+    1: Branch branch,
+    2: list<Branch> branches
+}
+
+struct Lists {
+    1: list<i32> i32_vals,
+    2: list<i64> i64_vals,
+    3: list<double> double_vals,
+    4: list<string> string_vals,
+    5: list<Flat> flat_vals
+}
+
+struct Maps {
+    1: map<i32,string> i32_map,
+    2: map<string,double> string_map
+}
+
+struct Blob {
+    1: binary data
+}
+
+enum Kind {
+    A = 1,
+    B = 2,
+    C = 3
+}
+
+struct Kinds {
+    1: Kind kind,
+    2: list<Kind> kinds
+}
+
+service BenchService {
+    Flat echo(1: Flat flat)
+}
@@ -0,0 +1 @@
+echo(flat::Flat) = flat
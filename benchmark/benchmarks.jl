@@ -0,0 +1,170 @@
+# Benchmarks for Thrift.jl, in the layout expected by PkgBenchmark (a `SUITE` BenchmarkGroup).
+#
+# Run with `PkgBenchmark.benchmarkpkg("Thrift")`, or directly:
+#
+#     julia --project=benchmark -e 'include("benchmark/benchmarks.jl"); display(run(SUITE; verbose=true))'
+#
+# Message types are generated from `bench.thrift` into a temporary directory. The suite measures
+# encoding, decoding and skipping of several message shapes with each protocol and transport
+# combination, and a client/server round trip over a loopback socket. Allocations per message are
+# reported along with the times in the benchmark results (`allocs` and `memory`).
+#
+# The code that `Thrift.generate` makes, which reads and writes messages with the generic methods
+# that go by the struct meta, is benchmarked as the "generic" variant. A compiler built with
+# `compiler/t_jl_generator.cc` can be passed in the `THRIFT_COMPILER` environment variable to also
+# benchmark the code it generates, side by side with the generic variant: with generated readers and
+# writers alone, and with each of the generator options. Other options to benchmark can be passed in
+# `THRIFT_GENERATOR_OPTIONS`, e.g. `typed_fields,binary_views`.
+
+using BenchmarkTools
+using Sockets
+using Thrift
+
+const BENCHDIR = @__DIR__
+const COMPILER = get(ENV, "THRIFT_COMPILER", "")
+
+# generator options of each variant benchmarked with `THRIFT_COMPILER`
+const VARIANT_OPTIONS = haskey(ENV, "THRIFT_GENERATOR_OPTIONS") ? Dict(ENV["THRIFT_GENERATOR_OPTIONS"] => ENV["THRIFT_GENERATOR_OPTIONS"]) : Dict(
+    "generated"    => "",
+    "typed_fields" => "typed_fields",
+    "binary_views" => "binary_views",
+    "typed_enums"  => "typed_enums",
+    "all_options"  => "typed_fields,binary_views,typed_enums",
+)
+
+# generate `bench.thrift` (with `compiler` and `options` if a compiler is given), and load it into a module of its own
+function generate_variant(name::String, compiler::String="", options::String="")
+    dir = mktempdir()
+    idl = joinpath(BENCHDIR, "bench.thrift")
+    if isempty(compiler)
+        Thrift.generate(idl; dir=dir)
+    else
+        gen = isempty(options) ? "jl" : "jl:$options"
+        run(Cmd(`$compiler -gen $gen $idl`; dir=dir))
+    end
+    gendir = joinpath(dir, "gen-jl", "bench")
+    cp(joinpath(BENCHDIR, "bench_impl.jl"), joinpath(gendir, "bench_impl.jl"); force=true)
+    wrapper = Module(Symbol("bench_", name))
+    Base.include(wrapper, joinpath(gendir, "bench.jl"))
+    getfield(wrapper, :bench)
+end
+
+const VARIANTS = Dict{String,Module}("generic" => generate_variant("generic"))
+if !isempty(COMPILER)
+    for (name, options) in VARIANT_OPTIONS
+        VARIANTS[name] = generate_variant(name, COMPILER, options)
+    end
+end
+
+##
+# Message shapes, made with the types of a variant
+
+flat(b::Module, idx::Integer=1) = b.Flat(; bool_val=isodd(idx), byte_val=UInt8(idx % 128), i16_val=Int16(idx % 1024), i32_val=Int32(idx), i64_val=Int64(idx) << 32, double_val=idx * 1.5, string_val="flat message $idx")
+leaf(b::Module, idx::Integer) = b.Leaf(; id=Int32(idx), flat=flat(b, idx))
+branch(b::Module, idx::Integer) = b.Branch(; leaf=leaf(b, idx), leaves=[leaf(b, idx * 10 + n) for n in 1:10])
+
+# the same values in each variant
+const DOUBLE_VALS = rand(1000)
+const BLOB_DATA = rand(UInt8, 1 << 20)
+
+messages(b::Module) = Dict(
+    "flat"   => flat(b),
+    "nested" => b.Nested(; branch=branch(b, 0), branches=[branch(b, n) for n in 1:10]),
+    "lists"  => b.Lists(; i32_vals=collect(Int32(1):Int32(1000)), i64_vals=collect(Int64(1):Int64(1000)), double_vals=copy(DOUBLE_VALS), string_vals=[string(n) for n in 1:1000], flat_vals=[flat(b, n) for n in 1:100]),
+    "maps"   => b.Maps(; i32_map=Dict{Int32,String}(Int32(n) => string(n) for n in 1:1000), string_map=Dict{String,Float64}(string(n) => n * 0.5 for n in 1:1000)),
+    "blob"   => b.Blob(; data=copy(BLOB_DATA)),
+    "enums"  => b.Kinds(; kind=b.Kind.B, kinds=[isodd(n) ? b.Kind.A : b.Kind.C for n in 1:1000]),
+)
+
+##
+# Protocol and transport combinations, each made over a memory transport that holds the serialized bytes
+
+const STACKS = Dict(
+    "binary/memory"  => mt -> TBinaryProtocol(mt),
+    "compact/memory" => mt -> TCompactProtocol(mt),
+    "binary/framed"  => mt -> TBinaryProtocol(TFramedTransport(mt)),
+    "compact/framed" => mt -> TCompactProtocol(TFramedTransport(mt)),
+    "header/header"  => mt -> THeaderProtocol(TBinaryProtocol(THeaderTransport(mt))),
+)
+
+# empty the memory transport (over a seekable buffer) without allocating, so that encoding can be repeated
+function reset!(mt::TMemoryTransport)
+    seekstart(mt.buff)
+    truncate(mt.buff, 0)
+    mt
+end
+
+function encode!(p::TProtocol, mt::TMemoryTransport, msg)
+    write(p, msg)
+    flush(p.t)
+    reset!(mt)
+end
+
+decode(p::TProtocol, T) = read(p, T)
+decode(p::THeaderProtocol, T) = (Thrift.read_frame!(p.t); read(p, T))
+
+skipmsg(p::TProtocol, T) = skip(p, T)
+skipmsg(p::THeaderProtocol, T) = (Thrift.read_frame!(p.t); skip(p, T))
+
+function serialized(mkproto, msg)
+    mt = TMemoryTransport()
+    p = mkproto(mt)
+    write(p, msg)
+    flush(p.t)
+    take!(mt.buff)
+end
+
+const SUITE = BenchmarkGroup()
+
+# variants are keyed last, so that they are listed side by side
+for (stackname, mkproto) in STACKS
+    g = SUITE[stackname] = BenchmarkGroup()
+    for (variant, b) in VARIANTS, (shape, msg) in messages(b)
+        T = typeof(msg)
+        bytes = serialized(mkproto, msg)
+        g[shape, "encode", variant] = @benchmarkable encode!(p, mt, $msg) setup=(mt = TMemoryTransport(IOBuffer()); p = $mkproto(mt))
+        g[shape, "decode", variant] = @benchmarkable decode(p, $T) setup=(p = $mkproto(TMemoryTransport(copy($bytes)))) evals=1
+        g[shape, "skip", variant]   = @benchmarkable skipmsg(p, $T) setup=(p = $mkproto(TMemoryTransport(copy($bytes)))) evals=1
+    end
+end
+
+##
+# Client/server round trip over a loopback socket
+
+const PORT = 19919
+
+function start_server(b::Module, port::Integer)
+    processor = b.BenchServiceProcessor()
+    # processors generated by older compilers can not recycle messages
+    applicable(recycle, processor) && recycle(processor)
+    srvr = TSimpleServer(TServerSocket("127.0.0.1", port), processor, x->TFramedTransport(x), x->TBinaryProtocol(x), x->TFramedTransport(x), x->TBinaryProtocol(x))
+    @async try
+        serve(srvr)
+    catch ex
+        isa(ex, Base.IOError) || @error("benchmark server stopped", exception=ex)
+    end
+    srvr
+end
+
+function connect_client(b::Module, port::Integer)
+    for attempt in 1:50
+        try
+            transport = TFramedTransport(TSocket("127.0.0.1", port))
+            open(transport)
+            return b.BenchServiceClient(TBinaryProtocol(transport))
+        catch ex
+            isa(ex, Base.IOError) || rethrow()
+            sleep(0.1)
+        end
+    end
+    error("could not connect to benchmark server on port $port")
+end
+
+SUITE["roundtrip"] = BenchmarkGroup()
+const SERVERS = Any[]
+for (idx, (variant, b)) in enumerate(VARIANTS)
+    port = PORT + idx - 1
+    push!(SERVERS, start_server(b, port))
+    client = connect_client(b, port)
+    SUITE["roundtrip"]["echo", "binary/framed", variant] = @benchmarkable $(b.echo)($client, $(flat(b)))
+end
@@ -2,6 +2,8 @@
 #include <fstream>
 #include <iostream>
 #include <vector>
+#include <map>
+#include <set>
 
 #include <stdlib.h>
 #include <sys/stat.h>
@@ -38,11 +40,29 @@ static const std::vector<string> julia_keywords(_julia_keywords, _julia_keywords
 class t_jl_generator: public t_generator {
 public:
 	t_jl_generator(t_program* program,
-			__attribute__((unused)) const std::map<std::string, std::string>& parsed_options,
+			const std::map<std::string, std::string>& parsed_options,
 			const std::string& option_string) :
 			t_generator(program) {
 		(void) option_string;
 		std::map<std::string, std::string>::const_iterator iter;
+
+		gen_typed_fields_ = false;
+		gen_binary_views_ = false;
+		gen_async_client_ = false;
+		gen_typed_enums_ = false;
+		for (iter = parsed_options.begin(); iter != parsed_options.end(); ++iter) {
+			if (iter->first.compare("typed_fields") == 0) {
+				gen_typed_fields_ = true;
+			} else if (iter->first.compare("binary_views") == 0) {
+				gen_binary_views_ = true;
+			} else if (iter->first.compare("async_client") == 0) {
+				gen_async_client_ = true;
+			} else if (iter->first.compare("typed_enums") == 0) {
+				gen_typed_enums_ = true;
+			} else {
+				throw "unknown option jl:" + iter->first;
+			}
+		}
 		out_dir_base_ = "gen-jl";
 	}
 
@@ -67,16 +87,23 @@ public:
 	 */
 	std::string render_const_value(t_type* type, t_const_value* value, bool with_conversion);
 	string julia_type(t_type *type);
+	string thrift_type_id(t_type *type);
 	void generate_jl_struct(ofstream& out, t_struct* tstruct, bool is_exception, string suffix="");
+	void generate_jl_struct_reader(ofstream& out, t_struct* tstruct, const string& struct_name);
+	void generate_jl_struct_writer(ofstream& out, t_struct* tstruct, const string& struct_name);
+	void generate_jl_struct_defaults(ofstream& out, t_struct* tstruct, const string& struct_name);
 	std::string jl_autogen_comment();
 	std::string jl_imports();
 	void generate_module_begin();
 	void generate_module_end();
 	void generate_service_args_and_returns(t_service* tservice);
 	void generate_service_processor(t_service* tservice);
+	void generate_service_dispatcher(t_service* tservice);
 	void generate_service_user_function_comments(t_service* tservice);
 	void generate_service_client(t_service* tservice);
+	void generate_service_async_client(t_service* tservice);
 	void add_to_module(t_service* tservice);
+	void generate_precompile();
 	bool is_keyword(const string &value);
 	string chk_keyword(const string &value);
 
@@ -93,9 +120,19 @@ private:
 	std::ostringstream module_exports_;
 	std::ostringstream module_using_;
 	std::ostringstream module_includes_;
+	std::ostringstream precompile_protocol_;	// precompile statements for each protocol P
+	std::ostringstream precompile_;			// other precompile statements
 
 	std::string package_dir_;
 	std::string program_dir_;
+
+	/**
+	 * Generator options
+	 */
+	bool gen_typed_fields_;		// concretely typed struct fields instead of a values Dict
+	bool gen_binary_views_;		// binary fields as views into the read buffer instead of copies
+	bool gen_async_client_;		// pipelined async client in addition to the blocking client
+	bool gen_typed_enums_;		// enums as a module with an @enum type instead of a struct of Int32 values
 };
 
 /**
@@ -139,10 +176,19 @@ void t_jl_generator::generate_module_end() {
 	f_module_ << endl << "export meta" << endl;
 	f_module_ << module_exports_.str() << endl;
 
-	f_module_ << "include(\"" << program_name_ << "_constants.jl\")" << endl;
-	f_module_ << "include(\"" << program_name_ << "_types.jl\")" << endl;
+	// typed enum constants refer to the enum types
+	if (gen_typed_enums_) {
+		f_module_ << "include(\"" << program_name_ << "_types.jl\")" << endl;
+		f_module_ << "include(\"" << program_name_ << "_constants.jl\")" << endl;
+	}
+	else {
+		f_module_ << "include(\"" << program_name_ << "_constants.jl\")" << endl;
+		f_module_ << "include(\"" << program_name_ << "_types.jl\")" << endl;
+	}
 	f_module_ << "include(\"" << program_name_ << "_impl.jl\")  # server methods to be hand coded" << endl;
 	f_module_ << module_includes_.str() << endl;
+	f_module_ << "include(\"" << program_name_ << "_precompile.jl\")" << endl;
+	f_module_ << "_precompile_()" << endl;
 
 	f_module_ << endl << "end # module " << program_name_ << endl;
 }
@@ -156,7 +202,7 @@ string t_jl_generator::julia_type(t_type *type) {
 		switch (tbase) {
 		case t_base_type::TYPE_STRING:
 			if (((t_base_type*)type)->is_binary()) {
-				return "Vector{UInt8}";
+				return gen_binary_views_ ? "Thrift.TBinaryView" : "Vector{UInt8}";
 			}
 			else {
 				return "String";
@@ -190,12 +236,56 @@ string t_jl_generator::julia_type(t_type *type) {
 	    t_type* vtype = ((t_map*)type)->get_val_type();
 		return ("Dict{" + julia_type(ktype) + "," + julia_type(vtype) + "}");
 	} else if(type->is_enum()) {
-		return "Int32";
+		return gen_typed_enums_ ? (chk_keyword(type->get_name()) + ".T") : "Int32";
 	}
 
 	return type->get_name();
 }
 
+/**
+ * Return the Thrift.TType constant for a type, as written on the wire
+ */
+string t_jl_generator::thrift_type_id(t_type *type) {
+	type = get_true_type(type);
+	if (type->is_base_type()) {
+		t_base_type::t_base tbase = ((t_base_type*) type)->get_base();
+		switch (tbase) {
+		case t_base_type::TYPE_STRING:
+			return "Thrift.TType.STRING";
+		case t_base_type::TYPE_BOOL:
+			return "Thrift.TType.BOOL";
+		case t_base_type::TYPE_I8:
+			return "Thrift.TType.BYTE";
+		case t_base_type::TYPE_I16:
+			return "Thrift.TType.I16";
+		case t_base_type::TYPE_I32:
+			return "Thrift.TType.I32";
+		case t_base_type::TYPE_I64:
+			return "Thrift.TType.I64";
+		case t_base_type::TYPE_DOUBLE:
+			return "Thrift.TType.DOUBLE";
+		default:
+			throw "compiler error: unknown base type " + t_base_type::t_base_name(tbase);
+		}
+	}
+	else if (type->is_enum()) {
+		return "Thrift.TType.I32";
+	}
+	else if (type->is_struct() || type->is_xception()) {
+		return "Thrift.TType.STRUCT";
+	}
+	else if (type->is_map()) {
+		return "Thrift.TType.MAP";
+	}
+	else if (type->is_set()) {
+		return "Thrift.TType.SET";
+	}
+	else if (type->is_list()) {
+		return "Thrift.TType.LIST";
+	}
+	throw "compiler error: no thrift type for " + type->get_name();
+}
+
 /**
  * Autogen'd comment
  */
@@ -211,7 +301,7 @@ string t_jl_generator::jl_autogen_comment() {
 string t_jl_generator::jl_imports() {
 	std::ostringstream out;
 
-	out << "using Thrift" << endl << "import Thrift.process, Thrift.meta, Thrift.distribute" << endl << endl;
+	out << "using Thrift" << endl << "import Thrift.process, Thrift.meta, Thrift.distribute, Thrift.recycle, Thrift.instrument, Thrift.metrics" << endl << endl;
 
 	const vector<t_program*>& includes = program_->get_includes();
 	for (size_t i = 0; i < includes.size(); ++i) {
@@ -229,6 +319,7 @@ string t_jl_generator::jl_imports() {
 void t_jl_generator::close_generator() {
 	f_types_.close();
 	f_consts_.close();
+	generate_precompile();
 	generate_module_end();
 	f_module_.close();
 }
@@ -260,17 +351,48 @@ string t_jl_generator::chk_keyword(const string &value) {
 
 /**
  * Generates code for an enumerated type. Done using a class to scope
- * the values.
+ * the values, along with a table of value names for enumstr.
+ * With the typed_enums option, done using a module to scope an @enum
+ * type named T.
  *
  * @param tenum The enumeration
  */
 void t_jl_generator::generate_enum(t_enum* tenum) {
 	vector<t_enum_value*> constants = tenum->get_constants();
 	string enum_name = chk_keyword(tenum->get_name());
+	vector<t_enum_value*>::const_iterator c_iter;
+
+	if (gen_typed_enums_) {
+		f_types_ << indent() << "baremodule " << enum_name << endl;
+		f_types_ << indent() << "import Base: @enum" << endl;
+		f_types_ << indent() << "@enum T::Int32 begin" << endl;
+		indent_up();
+		// @enum rejects duplicate values, names after the first with a value are bound to it as aliases
+		std::map<int, string> first_names;
+		vector<std::pair<string, string> > aliases;
+		for (c_iter = constants.begin(); c_iter != constants.end(); ++c_iter) {
+			string name = chk_keyword((*c_iter)->get_name());
+			std::map<int, string>::iterator n_iter = first_names.find((*c_iter)->get_value());
+			if (n_iter != first_names.end()) {
+				aliases.push_back(std::make_pair(name, n_iter->second));
+				continue;
+			}
+			first_names[(*c_iter)->get_value()] = name;
+			f_types_ << indent() << name << " = " << (*c_iter)->get_value() << endl;
+		}
+		indent_down();
+		f_types_ << indent() << "end" << endl;
+		vector<std::pair<string, string> >::iterator a_iter;
+		for (a_iter = aliases.begin(); a_iter != aliases.end(); ++a_iter) {
+			f_types_ << indent() << "const " << a_iter->first << " = " << a_iter->second << endl;
+		}
+		f_types_ << indent() << "end # module " << enum_name << endl << endl;
+		module_exports_ << "export " << enum_name << " # enum" << endl;
+		return;
+	}
 
 	f_types_ << indent() << "struct " << "_enum_" << enum_name << endl;
 	indent_up();
-	vector<t_enum_value*>::const_iterator c_iter;
 	for (c_iter = constants.begin(); c_iter != constants.end(); ++c_iter) {
 		f_types_ << indent() << chk_keyword((*c_iter)->get_name()) << "::Int32" << endl;
 	}
@@ -288,7 +410,22 @@ void t_jl_generator::generate_enum(t_enum* tenum) {
 	    }
 		f_types_ << "Int32(" << (*c_iter)->get_value() << ")";
 	}
-	f_types_ << ")" << endl << endl;
+	f_types_ << ")" << endl;
+
+	// in reverse, so that the first of names with the same value is used
+	f_types_ << indent() << "const __names__" << enum_name << " = Dict{Int32,String}(";
+	first = true;
+	vector<t_enum_value*>::const_reverse_iterator r_iter;
+	for (r_iter = constants.rbegin(); r_iter != constants.rend(); ++r_iter) {
+	    if (first) {
+	    	first = false;
+	    } else {
+	    	f_types_ << ", ";
+	    }
+		f_types_ << "Int32(" << (*r_iter)->get_value() << ") => \"" << chk_keyword((*r_iter)->get_name()) << "\"";
+	}
+	f_types_ << ")" << endl;
+	f_types_ << indent() << "Thrift.enumnames(::_enum_" << enum_name << ") = __names__" << enum_name << endl << endl;
 
 	module_exports_ << "export " << enum_name << " # enum" << endl;
 }
@@ -374,7 +511,7 @@ string t_jl_generator::render_const_value(t_type* type, t_const_value* value, bo
 			throw "compiler error: no const of base type " + t_base_type::t_base_name(tbase);
 		}
 	} else if (type->is_enum()) {
-		out << "Int32(" << value->get_integer() << ")";
+		out << (gen_typed_enums_ ? (chk_keyword(type->get_name()) + ".T(") : "Int32(") << value->get_integer() << ")";
 	} else if (type->is_struct() || type->is_xception()) {
 		throw "compiler error: struct constants are not implemented yet";
 	} else if (type->is_map()) {
@@ -461,7 +598,7 @@ void t_jl_generator::generate_jl_struct(ofstream& out, t_struct* tstruct, bool i
 
 	indent(out) << endl << "mutable struct " << struct_name;
 
-	out << " <: Thrift.TMsg";
+	out << (gen_typed_fields_ ? " <: Thrift.TTypedMsg" : " <: Thrift.TMsg");
 	if (is_exception) {
 		out << " # Exception";
 	}
@@ -469,19 +606,41 @@ void t_jl_generator::generate_jl_struct(ofstream& out, t_struct* tstruct, bool i
 	indent_up();
 
 	indent(out) << "meta::ThriftMeta" << endl;
-	indent(out) << "values::Dict{Symbol,Any}" << endl;
+	if (gen_typed_fields_) {
+		for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
+			indent(out) << chk_keyword((*m_iter)->get_name()) << "::Union{Nothing," << julia_type((*m_iter)->get_type()) << "}" << endl;
+		}
+	}
+	else {
+		indent(out) << "values::Dict{Symbol,Any}" << endl;
+	}
 	indent(out) << endl;
 	indent(out) << "function " << struct_name << "(; kwargs...)" << endl;
 	indent_up();
-	indent(out) << "obj = new(__meta__" << struct_name << ", Dict{Symbol,Any}())" << endl;
-	indent(out) << "values = obj.values" << endl;
+	if (gen_typed_fields_) {
+		indent(out) << "obj = new(__meta__" << struct_name;
+		for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
+			out << ", nothing";
+		}
+		out << ")" << endl;
+	}
+	else {
+		indent(out) << "obj = new(__meta__" << struct_name << ", Dict{Symbol,Any}())" << endl;
+		indent(out) << "values = obj.values" << endl;
+	}
 	indent(out) << "symdict = obj.meta.symdict" << endl;
 	indent(out) << "for nv in kwargs" << endl;
 	indent_up();
 	indent(out) << "fldname, fldval = nv" << endl;
-	indent(out) << "fldtype = symdict[fldname].jtype" << endl;
-	indent(out) << "(fldname in keys(symdict)) || error(string(typeof(obj), \" has no field with name \", fldname))" << endl;
-	indent(out) << "values[fldname] = isa(fldval, fldtype) ? fldval : convert(fldtype, fldval)" << endl;
+	if (gen_typed_fields_) {
+		indent(out) << "(fldname in keys(symdict)) || error(string(typeof(obj), \" has no field with name \", fldname))" << endl;
+		indent(out) << "setproperty!(obj, fldname, fldval)" << endl;
+	}
+	else {
+		indent(out) << "fldtype = symdict[fldname].jtype" << endl;
+		indent(out) << "(fldname in keys(symdict)) || error(string(typeof(obj), \" has no field with name \", fldname))" << endl;
+		indent(out) << "values[fldname] = isa(fldval, fldtype) ? fldval : convert(fldtype, fldval)" << endl;
+	}
 	indent_down();
 	indent(out) << "end" << endl;
 	indent(out) << "Thrift.setdefaultproperties!(obj)" << endl;
@@ -497,6 +656,7 @@ void t_jl_generator::generate_jl_struct(ofstream& out, t_struct* tstruct, bool i
 	std::ostringstream fldnums;
 	std::ostringstream flddefaults;
 	std::ostringstream getconditions;
+	std::ostringstream setconditions;
 	bool need_fldnums = false;
 	int default_fld_num = 1;
 	for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
@@ -516,7 +676,15 @@ void t_jl_generator::generate_jl_struct(ofstream& out, t_struct* tstruct, bool i
 		else {
 			getconditions << "  elseif name === ";
 		}
-		getconditions << ":" << fld_name << endl << "    return (obj.values[name])::" << fld_type << endl;
+		if (gen_typed_fields_) {
+			getconditions << ":" << fld_name << endl << "    return (Thrift.fieldvalue(obj, :" << fld_name << "))::" << fld_type << endl;
+
+			setconditions << (setconditions.str().empty() ? "  if name === " : "  elseif name === ");
+			setconditions << ":" << fld_name << endl << "    setfield!(obj, :" << fld_name << ", isa(val, " << fld_type << ") ? val : convert(" << fld_type << ", val))" << endl;
+		}
+		else {
+			getconditions << ":" << fld_name << endl << "    return (obj.values[name])::" << fld_type << endl;
+		}
 
 		if (fld->get_req() == t_field::T_OPTIONAL) {
 			if(!fldoptional.str().empty()) (fldoptional << ",");
@@ -553,7 +721,147 @@ void t_jl_generator::generate_jl_struct(ofstream& out, t_struct* tstruct, bool i
 		out << endl << "function Base.getproperty(obj::" << struct_name << ", name::Symbol)" << endl << getconditions.str() << endl << "end" << endl;
 	}
 
-	out << endl << "meta(::Type{" << struct_name << "}) = __meta__" << struct_name << endl << endl;
+	if(!setconditions.str().empty()) {
+		setconditions << "  else" << endl << "    setfield!(obj, name, val)" << endl << "  end";
+		out << endl << "function Base.setproperty!(obj::" << struct_name << ", name::Symbol, val)" << endl << setconditions.str() << endl << "end" << endl;
+	}
+
+	out << endl << "meta(::Type{" << struct_name << "}) = __meta__" << struct_name << endl;
+
+	generate_jl_struct_defaults(out, tstruct, struct_name);
+
+	precompile_protocol_ << "        precompile(Thrift.read_container, (P, " << struct_name << "))" << endl;
+	precompile_protocol_ << "        precompile(Thrift.write_container, (P, " << struct_name << "))" << endl;
+
+	generate_jl_struct_reader(out, tstruct, struct_name);
+	generate_jl_struct_writer(out, tstruct, struct_name);
+	out << endl;
+}
+
+/**
+ * Generates a setter of default values for a struct, that sets unset fields
+ * with a default to a new value built from the default's literal.
+ */
+void t_jl_generator::generate_jl_struct_defaults(ofstream& out, t_struct* tstruct, const string& struct_name) {
+	const vector<t_field*>& members = tstruct->get_members();
+	vector<t_field*>::const_iterator m_iter;
+
+	std::ostringstream defaults;
+	for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
+		t_field* fld = (*m_iter);
+		if (fld->get_value() != NULL) {
+			string fld_name = chk_keyword(fld->get_name());
+			t_type* type = get_true_type(fld->get_type());
+			defaults << "  hasproperty(val, :" << fld_name << ") || (val." << fld_name << " = " << render_const_value(type, fld->get_value(), true) << ")" << endl;
+		}
+	}
+
+	if (defaults.str().empty()) {
+		out << endl << "Thrift.setdefaultproperties!(val::" << struct_name << ") = val" << endl;
+	}
+	else {
+		out << endl << "function Thrift.setdefaultproperties!(val::" << struct_name << ")" << endl << defaults.str() << "  val" << endl << "end" << endl;
+	}
+}
+
+/**
+ * Generates a specialized reader for a struct, with a branch per field id.
+ * Unknown fields and fields with an unexpected type on the wire are skipped.
+ */
+void t_jl_generator::generate_jl_struct_reader(ofstream& out, t_struct* tstruct, const string& struct_name) {
+	const vector<t_field*>& members = tstruct->get_members();
+	vector<t_field*>::const_iterator m_iter;
+
+	out << endl << "function Thrift.read_container(p::TProtocol, val::" << struct_name << ")" << endl;
+	indent_up();
+	indent(out) << "Thrift.readStructBegin(p)" << endl;
+	indent(out) << "clear(val)" << endl;
+	indent(out) << "while true" << endl;
+	indent_up();
+	indent(out) << "(name, ttyp, id) = Thrift.readFieldBegin(p)" << endl;
+	indent(out) << "(ttyp == Thrift.TType.STOP) && break" << endl;
+
+	bool first = true;
+	for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
+		t_field* fld = (*m_iter);
+		t_type* type = get_true_type(fld->get_type());
+		string fld_type = julia_type(fld->get_type());
+
+		indent(out) << (first ? "if " : "elseif ") << "(id == " << fld->get_key() << ") && (ttyp == " << thrift_type_id(type) << ")" << endl;
+		indent_up();
+		indent(out) << "val." << chk_keyword(fld->get_name()) << " = ";
+		if (type->is_container() || type->is_struct() || type->is_xception()) {
+			out << "Thrift.read_container(p, " << fld_type << "())" << endl;
+		}
+		else {
+			out << "Thrift.read(p, " << fld_type << ")" << endl;
+		}
+		indent_down();
+		first = false;
+	}
+	if (!first) {
+		indent(out) << "else" << endl;
+		indent_up();
+	}
+	indent(out) << "Thrift.skip_value(p, ttyp)" << endl;
+	if (!first) {
+		indent_down();
+		indent(out) << "end" << endl;
+	}
+
+	indent(out) << "Thrift.readFieldEnd(p)" << endl;
+	indent_down();
+	indent(out) << "end" << endl;
+	indent(out) << "Thrift.readStructEnd(p)" << endl;
+	indent(out) << "Thrift.setdefaultproperties!(val)" << endl;
+	indent_down();
+	out << "end" << endl;
+}
+
+/**
+ * Generates a specialized straight line writer for a struct.
+ */
+void t_jl_generator::generate_jl_struct_writer(ofstream& out, t_struct* tstruct, const string& struct_name) {
+	const vector<t_field*>& members = tstruct->get_members();
+	vector<t_field*>::const_iterator m_iter;
+
+	out << endl << "function Thrift.write_container(p::TProtocol, val::" << struct_name << ")" << endl;
+	indent_up();
+	indent(out) << "Thrift.writeStructBegin(p, \"" << struct_name << "\")" << endl;
+
+	for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
+		t_field* fld = (*m_iter);
+		t_type* type = get_true_type(fld->get_type());
+		string fld_name = chk_keyword(fld->get_name());
+
+		indent(out) << "if hasproperty(val, :" << fld_name << ")" << endl;
+		indent_up();
+		indent(out) << "Thrift.writeFieldBegin(p, \"" << fld_name << "\", " << thrift_type_id(type) << ", " << fld->get_key() << ")" << endl;
+		if (type->is_base_type() && ((t_base_type*)type)->get_base() == t_base_type::TYPE_BOOL) {
+			indent(out) << "Thrift.writeBool(p, val." << fld_name << ")" << endl;
+		}
+		else if (type->is_base_type() && ((t_base_type*)type)->is_binary()) {
+			indent(out) << "Thrift.write(p, val." << fld_name << ", true)" << endl;
+		}
+		else {
+			indent(out) << "Thrift.write(p, val." << fld_name << ")" << endl;
+		}
+		indent(out) << "Thrift.writeFieldEnd(p)" << endl;
+		indent_down();
+		if (fld->get_req() != t_field::T_OPTIONAL) {
+			indent(out) << "else" << endl;
+			indent_up();
+			indent(out) << "error(\"required field " << fld_name << " not populated\")" << endl;
+			indent_down();
+		}
+		indent(out) << "end" << endl;
+	}
+
+	indent(out) << "Thrift.writeFieldStop(p)" << endl;
+	indent(out) << "Thrift.writeStructEnd(p)" << endl;
+	indent(out) << "nothing" << endl;
+	indent_down();
+	out << "end" << endl;
 }
 
 void t_jl_generator::add_to_module(t_service* tservice) {
@@ -562,11 +870,18 @@ void t_jl_generator::add_to_module(t_service* tservice) {
 	module_includes_ << "include(\"" << service_name_ << ".jl\")" << endl;
 
 	module_exports_ << "export " << service_name_ << "Processor, " << service_name_ << "Client, " << service_name_ << "ClientBase";
+	if (gen_async_client_) {
+		module_exports_ << ", " << service_name_ << "AsyncClient, " << service_name_ << "AsyncClientBase";
+	}
 	vector<t_function*> functions = tservice->get_functions();
 	vector<t_function*>::iterator f_iter;
 	for (f_iter = functions.begin(); f_iter != functions.end(); ++f_iter) {
 		module_exports_ << ", " << chk_keyword((*f_iter)->get_name());
 	}
+	// handlers are referred to by the processors of services extending this one
+	for (f_iter = functions.begin(); f_iter != functions.end(); ++f_iter) {
+		module_exports_ << ", __handler__" << chk_keyword((*f_iter)->get_name()) << "_" << service_name_;
+	}
 	module_exports_ << " # service " << service_name_ << endl;
 }
 
@@ -587,7 +902,7 @@ void t_jl_generator::generate_service_processor(t_service* tservice) {
 		string result_type = tfunction->is_oneway() ? "Nothing" : (fname + "_result_" + service_name_);
 		string args_type = (fname + "_args_" + service_name_);
 
-		indent(f_service_) << "handle(p.tp, ThriftHandler(\"" << fname << "\", _" << fname << ", " << args_type << ", " << result_type << "))" << endl;
+		indent(f_service_) << "handle(p.tp, __handler__" << fname << "_" << service_name_ << ")" << endl;
 	}
 
 	t_service* extends_service = tservice->get_extends();
@@ -613,111 +928,135 @@ void t_jl_generator::generate_service_processor(t_service* tservice) {
 		string args_type = (fname + "_args_" + service_name_);
 		string result_type = tfunction->is_oneway() ? "Nothing" : (fname + "_result_" + service_name_);
 
-		if(has_xceptions) {
-			indent(f_service_) << "function _" << fname << "(inp::" << args_type << ")" << endl;
+		// call to the user implemented function, with arguments taken from the args struct
+		string call = fname + "(";
+		const vector<t_field*>& members = arglist->get_members();
+		vector<t_field*>::const_iterator m_iter;
+		for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
+			if (m_iter != members.begin()) {
+				call += ", ";
+			}
+			call += "inp." + chk_keyword((*m_iter)->get_name());
+		}
+		call += ")";
+
+		// the result struct can be passed in by the processor, to reuse pooled instances
+		string signature = "_" + fname + "(inp::" + args_type + (oneway ? ")" : (", outp::" + result_type + "=" + result_type + "())"));
+
+		if(oneway) {
+			indent(f_service_) << signature << " = (" << call << "; nothing)" << endl;
+		}
+		else if(has_xceptions) {
+			indent(f_service_) << "function " << signature << endl;
 			indent_up();
 			indent(f_service_) << "try" << endl;
 			indent_up();
-
 			if(!ttype->is_void()) {
-				indent(f_service_) << "result = " << fname << "(";
-			}
-			else {
-				indent(f_service_) << fname << "(";
-			}
-
-			const vector<t_field*>& members = arglist->get_members();
-			vector<t_field*>::const_iterator m_iter;
-			bool first = true;
-			for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
-				if (first) {
-					first = false;
-				} else {
-					f_service_ << ", ";
-				}
-				t_field* fld= (*m_iter);
-				f_service_ << "inp." << chk_keyword(fld->get_name());
-			}
-			f_service_ << ")" << endl;
-			if(oneway) {
-				indent(f_service_) << "return" << endl;
-			}
-			else if(!ttype->is_void()) {
-				indent(f_service_) << "return " << result_type << "(;success=result)" << endl;
+				indent(f_service_) << "outp.success = " << call << endl;
 			}
 			else {
-				indent(f_service_) << "return " << result_type << "()" << endl;
+				indent(f_service_) << call << endl;
 			}
+			indent(f_service_) << "return outp" << endl;
 			indent_down();
 			indent(f_service_) << "catch ex" << endl;
 			indent_up();
 
-			if(oneway) {
-				indent(f_service_) << "// ignore exceptions in oneway functions" << endl;
+			const vector<t_field*>& xmembers = xceptions->get_members();
+			vector<t_field*>::const_iterator x_iter;
+			for (x_iter = xmembers.begin(); x_iter != xmembers.end(); ++x_iter) {
+				t_field* fld= (*x_iter);
+				indent(f_service_) << "isa(ex, " << julia_type(fld->get_type()) << ") && (outp." << chk_keyword(fld->get_name()) << " = ex; return outp)" << endl;
 			}
-			else {
-				indent(f_service_) << "exret = " << result_type << "()" << endl;
-
-				const vector<t_field*>& xmembers = xceptions->get_members();
-				vector<t_field*>::const_iterator x_iter;
-				for (x_iter = xmembers.begin(); x_iter != xmembers.end(); ++x_iter) {
-					t_field* fld= (*x_iter);
-					indent(f_service_) << "isa(ex, " << julia_type(fld->get_type()) << ") && (exret." << chk_keyword(fld->get_name()) << " = ex; return exret)" << endl;
-				}
 
-				indent(f_service_) << "rethrow()" << endl;
-			}
+			indent(f_service_) << "rethrow()" << endl;
 			indent_down();
 			indent(f_service_) << "end # try" << endl;
 			indent_down();
 			indent(f_service_) << "end #function _" << fname << endl;
 		}
-		else if(!ttype->is_void() && !oneway) {
-			indent(f_service_) << "_" << fname << "(inp::" << args_type << ") = " << result_type << "(; success=" << fname << "(";
-
-			const vector<t_field*>& members = arglist->get_members();
-			vector<t_field*>::const_iterator m_iter;
-			bool first = true;
-			for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
-				if (first) {
-					first = false;
-				} else {
-					f_service_ << ", ";
-				}
-				t_field* fld= (*m_iter);
-				f_service_ << "inp." << chk_keyword(fld->get_name());
-			}
-			f_service_ << "))" << endl;
-		}
-		else if(!ttype->is_void() && oneway) {
-			indent(f_service_) << "_" << fname << "(inp::" << args_type << ") = (" << fname << "(";
-
-			const vector<t_field*>& members = arglist->get_members();
-			vector<t_field*>::const_iterator m_iter;
-			bool first = true;
-			for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
-				if (first) {
-					first = false;
-				} else {
-					f_service_ << ", ";
-				}
-				t_field* fld= (*m_iter);
-				f_service_ << "inp." << chk_keyword(fld->get_name());
-			}
-			f_service_ << "); nothing)" << endl;
+		else if(!ttype->is_void()) {
+			indent(f_service_) << signature << " = (outp.success = " << call << "; outp)" << endl;
 		}
 		else {
-			if(oneway) {
-				indent(f_service_) << "_" << fname << "(inp::" << args_type << ") = (" << fname << "(); " << "nothing)" << endl;
-			}
-			else {
-				indent(f_service_) << "_" << fname << "(inp::" << args_type << ") = (" << fname << "(); " << result_type << "())" << endl;
-			}
+			indent(f_service_) << signature << " = (" << call << "; outp)" << endl;
 		}
 	}
 
-	f_service_ << "process(p::" << service_name_ << "Processor, inp::TProtocol, outp::TProtocol) = process(p.tp, inp, outp)" << endl;
+	f_service_ << endl;
+	for (f_iter = functions.begin(); f_iter != functions.end(); ++f_iter) {
+		t_function* tfunction = (*f_iter);
+		string fname = chk_keyword(tfunction->get_name());
+		string result_type = tfunction->is_oneway() ? "Nothing" : (fname + "_result_" + service_name_);
+		string args_type = (fname + "_args_" + service_name_);
+
+		f_service_ << "const __handler__" << fname << "_" << service_name_ << " = ThriftHandler(\"" << fname << "\", _" << fname << ", " << args_type << ", " << result_type << ")" << endl;
+	}
+	f_service_ << endl;
+
+	generate_service_dispatcher(tservice);
+	precompile_protocol_ << "        precompile(process, (" << service_name_ << "Processor, P, P))" << endl;
+	for (f_iter = functions.begin(); f_iter != functions.end(); ++f_iter) {
+		t_function* tfunction = (*f_iter);
+		string fname = chk_keyword(tfunction->get_name());
+		string args_type = (fname + "_args_" + service_name_);
+		string result_type = (fname + "_result_" + service_name_);
+		precompile_ << "    precompile(_" << fname << ", (" << args_type << (tfunction->is_oneway() ? "," : (", " + result_type)) << "))" << endl;
+		// the concrete handler type, so that decoding, the call and encoding are compiled for this function
+		precompile_protocol_ << "        precompile(Thrift._process, (Thrift.ThriftProcessor, P, P, String, Int32, Int32, typeof(__handler__" << fname << "_" << service_name_ << ")))" << endl;
+	}
+
 	f_service_ << "distribute(p::" << service_name_ << "Processor) = distribute(p.tp)" << endl;
+	f_service_ << "recycle(p::" << service_name_ << "Processor, use_pool::Bool=true) = recycle(p.tp, use_pool)" << endl;
+	f_service_ << "instrument(p::" << service_name_ << "Processor, m::Union{Nothing,ThriftMetrics}=ThriftMetrics()) = instrument(p.tp, m)" << endl;
+	f_service_ << "metrics(p::" << service_name_ << "Processor) = metrics(p.tp)" << endl;
+}
+
+/**
+ * Generates the request dispatcher for a service processor.
+ * Method names are matched by their length first and then their bytes, and each branch
+ * calls the handler for the method directly. Methods of extended services are included.
+ */
+void t_jl_generator::generate_service_dispatcher(t_service* tservice) {
+	// method name => (processor core, handler), grouped by name length
+	// methods of an extended service run with the processor core of that service, and so with its settings
+	std::map<size_t, vector<std::pair<string, std::pair<string, string> > > > by_length;
+	std::set<string> seen;
+	string tp = "p.tp";
+	for (t_service* svc = tservice; svc != NULL; svc = svc->get_extends(), tp += ".extends") {
+		vector<t_function*> functions = svc->get_functions();
+		vector<t_function*>::iterator f_iter;
+		for (f_iter = functions.begin(); f_iter != functions.end(); ++f_iter) {
+			string fname = chk_keyword((*f_iter)->get_name());
+			if (!seen.insert(fname).second) {
+				continue;
+			}
+			string handler = "__handler__" + fname + "_" + svc->get_name();
+			by_length[fname.size()].push_back(std::make_pair(fname, std::make_pair(tp, handler)));
+		}
+	}
+
+	f_service_ << "function process(p::" << service_name_ << "Processor, inp::TProtocol, outp::TProtocol, outlock::ReentrantLock...)" << endl;
+	indent_up();
+	indent(f_service_) << "(name, typ, seqid) = Thrift.readMessageBegin(inp)" << endl;
+	indent(f_service_) << "len = sizeof(name)" << endl;
+
+	std::map<size_t, vector<std::pair<string, std::pair<string, string> > > >::iterator l_iter;
+	for (l_iter = by_length.begin(); l_iter != by_length.end(); ++l_iter) {
+		indent(f_service_) << ((l_iter == by_length.begin()) ? "if" : "elseif") << " len == " << l_iter->first << endl;
+		indent_up();
+		vector<std::pair<string, std::pair<string, string> > >::iterator n_iter;
+		for (n_iter = l_iter->second.begin(); n_iter != l_iter->second.end(); ++n_iter) {
+			indent(f_service_) << "(name == \"" << n_iter->first << "\") && (return Thrift._process(" << n_iter->second.first << ", inp, outp, name, typ, seqid, " << n_iter->second.second << ", outlock...))" << endl;
+		}
+		indent_down();
+	}
+	if (!by_length.empty()) {
+		indent(f_service_) << "end" << endl;
+	}
+	indent(f_service_) << "Thrift._unknown(inp, outp, name, seqid, outlock...)" << endl;
+	indent_down();
+	f_service_ << "end" << endl;
 }
 
 void t_jl_generator::generate_service_user_function_comments(t_service* tservice) {
@@ -794,14 +1133,17 @@ void t_jl_generator::generate_service_client(t_service* tservice) {
 
 		f_service_ << "# Client callable method for " << fname << endl;
 		f_service_ << "function " << fname << "(c::" << service_name_client << "Base";
+		precompile_ << "    precompile(" << fname << ", (" << service_name_client;
 
 		const vector<t_field*>& members = arglist->get_members();
 		vector<t_field*>::const_iterator m_iter;
 		for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
 			t_field* fld= (*m_iter);
 			f_service_ << ", " << chk_keyword(fld->get_name()) << "::" << julia_type(fld->get_type());
+			precompile_ << ", " << julia_type(fld->get_type());
 		}
 		f_service_ << ")" << endl;
+		precompile_ << (members.empty() ? ",))" : "))") << endl;
 		indent_up();
 
 		indent(f_service_) << "p = c.p" << endl;
@@ -850,6 +1192,116 @@ void t_jl_generator::generate_service_client(t_service* tservice) {
 	}
 }
 
+void t_jl_generator::generate_service_async_client(t_service* tservice) {
+	f_service_ << "# Async client implementation for " << service_name_ << " service" << endl;
+	f_service_ << "# Calls return a Task that gives the result (or throws the exception) when fetched." << endl;
+	string service_name_client = (service_name_ + "AsyncClient");
+
+	t_service* extends_service = tservice->get_extends();
+	if (extends_service == NULL) {
+		f_types_ << endl << "abstract type " << service_name_client << "Base end" << endl;
+	}
+	else {
+		f_types_ << endl << "const " << service_name_client << "Base = " << chk_keyword(extends_service->get_name()) << "AsyncClientBase" << endl;
+	}
+
+	f_service_ << "mutable struct " << service_name_client << " <: " << service_name_client << "Base" << endl;
+	indent_up();
+	indent(f_service_) << "conn::ThriftAsyncConnection" << endl;
+	indent(f_service_) << service_name_client << "(p::TProtocol) = new(ThriftAsyncConnection(p))" << endl;
+	indent(f_service_) << service_name_client << "(inp::TProtocol, outp::TProtocol) = new(ThriftAsyncConnection(inp, outp))" << endl;
+	indent(f_service_) << service_name_client << "(conn::ThriftAsyncConnection) = new(conn)" << endl;
+	indent_down();
+	f_service_ << "end # mutable struct " << service_name_client << endl << endl;
+
+	vector<t_function*> functions = tservice->get_functions();
+	vector<t_function*>::iterator f_iter;
+	for (f_iter = functions.begin(); f_iter != functions.end(); ++f_iter) {
+		t_function* tfunction = (*f_iter);
+		bool oneway = tfunction->is_oneway();
+		t_type* ttype = tfunction->get_returntype();
+		t_struct* arglist = tfunction->get_arglist();
+		string fname = chk_keyword(tfunction->get_name());
+		t_struct* xceptions = tfunction->get_xceptions();
+		bool has_xceptions = !xceptions->get_members().empty();
+		string args_type = (fname + "_args_" + service_name_);
+		string result_type = (fname + "_result_" + service_name_);
+
+		f_service_ << "# Async client callable method for " << fname << endl;
+		f_service_ << "function " << fname << "(c::" << service_name_client << "Base";
+
+		const vector<t_field*>& members = arglist->get_members();
+		vector<t_field*>::const_iterator m_iter;
+		for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
+			t_field* fld= (*m_iter);
+			f_service_ << ", " << chk_keyword(fld->get_name()) << "::" << julia_type(fld->get_type());
+		}
+		f_service_ << ")" << endl;
+		indent_up();
+
+		indent(f_service_) << "inp = " << args_type << "()" << endl;
+		for (m_iter = members.begin(); m_iter != members.end(); ++m_iter) {
+			t_field* fld= (*m_iter);
+			string fld_name = chk_keyword(fld->get_name());
+			indent(f_service_) << "inp." << fld_name << " = " << fld_name << endl;
+		}
+
+		if (oneway) {
+			indent(f_service_) << "Thrift.call(c.conn, \"" << fname << "\", Thrift.MessageType.ONEWAY, inp, nothing)" << endl;
+			indent(f_service_) << "nothing" << endl;
+			indent_down();
+			f_service_ << "end # function " << fname << endl << endl;
+			continue;
+		}
+
+		indent(f_service_) << "ch = Thrift.call(c.conn, \"" << fname << "\", Thrift.MessageType.CALL, inp, " << result_type << "())" << endl;
+		indent(f_service_) << "@async begin" << endl;
+		indent_up();
+		indent(f_service_) << "outp = Thrift.reply(ch)" << endl;
+		if(has_xceptions) {
+			const vector<t_field*>& xmembers = xceptions->get_members();
+			vector<t_field*>::const_iterator x_iter;
+			for (x_iter = xmembers.begin(); x_iter != xmembers.end(); ++x_iter) {
+				t_field* fld= (*x_iter);
+				string fld_name = chk_keyword(fld->get_name());
+				indent(f_service_) << "hasproperty(outp, :" << fld_name << ") && throw(outp." << fld_name << ")" << endl;
+			}
+		}
+		if (ttype->is_void()) {
+			indent(f_service_) << "nothing" << endl;
+		}
+		else {
+			indent(f_service_) << "hasproperty(outp, :success) && (return outp.success)" << endl;
+			indent(f_service_) << "throw(Thrift.TApplicationException(; typ=Thrift.ApplicationExceptionType.MISSING_RESULT, message=\"retrieve failed: unknown result\"))" << endl;
+		}
+		indent_down();
+		indent(f_service_) << "end" << endl;
+		indent_down();
+		f_service_ << "end # function " << fname << endl << endl;
+	}
+}
+
+/**
+ * Generates the precompile statements of the program, for the read and write methods of all structs
+ * with the binary and compact protocols, and the processor, handler and client methods of all services.
+ * These run only while the module is being precompiled.
+ */
+void t_jl_generator::generate_precompile() {
+	string f_precompile_name = program_dir_ + "/" + program_name_ + "_precompile.jl";
+	ofstream f_precompile;
+	f_precompile.open(f_precompile_name.c_str());
+	f_precompile << jl_autogen_comment() << endl;
+
+	f_precompile << "function _precompile_()" << endl;
+	f_precompile << "    (ccall(:jl_generating_output, Cint, ()) == 1) || return nothing" << endl;
+	f_precompile << "    for P in (TBinaryProtocol, TCompactProtocol)" << endl;
+	f_precompile << precompile_protocol_.str();
+	f_precompile << "    end" << endl;
+	f_precompile << precompile_.str();
+	f_precompile << "    nothing" << endl;
+	f_precompile << "end" << endl;
+	f_precompile.close();
+}
 
 void t_jl_generator::generate_service_args_and_returns(t_service* tservice) {
 	vector<t_function*> functions = tservice->get_functions();
@@ -918,6 +1370,10 @@ void t_jl_generator::generate_service(t_service* tservice) {
 	generate_service_user_function_comments(tservice);
 	f_service_ << endl << endl;
 	generate_service_client(tservice);
+	if (gen_async_client_) {
+		f_service_ << endl << endl;
+		generate_service_async_client(tservice);
+	}
 
 	// accumulate exports and includes for module file
 	add_to_module(tservice);
@@ -926,4 +1382,10 @@ void t_jl_generator::generate_service(t_service* tservice) {
 	f_service_.close();
 }
 
-THRIFT_REGISTER_GENERATOR(jl, "Julia", "")
+THRIFT_REGISTER_GENERATOR(
+	jl,
+	"Julia",
+	"    typed_fields:    Generate structs with concretely typed fields instead of a Dict of values.\n"
+	"    binary_views:    Read binary fields as views into the transport's read buffer, without copying.\n"
+	"    async_client:    Also generate a pipelined client that can be shared by many tasks.\n"
+	"    typed_enums:     Generate enums as Julia @enum types instead of Int32 constants.\n")
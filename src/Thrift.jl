@@ -1,6 +1,7 @@
 module Thrift
 
 using Distributed
+using Mmap
 using Sockets
 using ThriftJuliaCompiler_jll
 
@@ -14,7 +15,7 @@ import Base: open, close, isopen, read, read!, write, flush, skip, show, copy!,
 export open, close, isopen, read, read!, write, flush, skip, listen, accept, show, copy!
 
 # from base.jl
-export TSTOP, TVOID, TBOOL, TBYTE, TI08, TDOUBLE, TI16, TI32, TI64, TSTRING, TUTF7, TSTRUCT, TMAP, TSET, TLIST, TUTF8, TUTF16
+export TSTOP, TVOID, TBOOL, TBYTE, TI08, TDOUBLE, TI16, TI32, TI64, TSTRING, TUTF7, TSTRUCT, TMAP, TSET, TLIST, TUTF8, TUTF16, TBinaryView
 export TType, TProcessor, TTransport, TServerTransport, TServer, TProtocol
 export writeMessageBegin, writeMessageEnd, writeStructBegin, writeStructEnd, writeFieldBegin, writeFieldEnd, writeFieldStop, writeMapBegin, writeMapEnd, writeListBegin, writeListEnd, writeSetBegin, writeSetEnd, writeBool, writeByte, writeI16, writeI32, writeI64, writeDouble, writeString
 export readMessageBegin, readMessageEnd, readStructBegin, readStructEnd, readFieldBegin, readFieldEnd, readMapBegin, readMapEnd, readListBegin, readListEnd, readSetBegin, readSetEnd, readBool, readByte, readI16, readI32, readI64, readDouble, readString
@@ -22,8 +23,11 @@ export ApplicationExceptionType, MessageType, TException, TApplicationException
 export ThriftMetaAttribs, ThriftMeta, meta
 export isinitialized, set_field!, get_field, clear, has_field, fillunset, isfilled, thriftbuild, enumstr
 
+# from lazy.jl
+export TLazyStruct, materialize
+
 # from transports.jl
-export TFramedTransport, TSASLClientTransport, TSocket, TServerSocket, TSocketBase, TMemoryTransport, TFileTransport, THeaderTransport
+export TFramedTransport, TBufferedTransport, TSASLClientTransport, TSocket, TServerSocket, TSocketBase, TMemoryTransport, TFileTransport, THeaderTransport
 export TransportExceptionTypes, TTransportException
 
 # from sasl.jl
@@ -32,15 +36,25 @@ export SASL_MECH_PLAIN, SASL_MECH_KERB, SASL_MECH_LDAP, SASLException
 # from protocols.jl
 export TBinaryProtocol, TCompactProtocol, THeaderProtocol
 
+# from recordio.jl
+export TRecordWriter, TRecordReader, writerecord
+
 # from processor.jl
-export ThriftProcessor, ThriftHandler, process, handle, extend, distribute
+export ThriftProcessor, ThriftHandler, process, handle, extend, distribute, recycle, instrument
+
+# from metrics.jl
+export ThriftMetrics, TMeteredTransport, snapshot, write_prometheus
+
+# from client.jl
+export ThriftAsyncConnection, ThriftClientPool, withclient
 
 # from server.jl
-export TSimpleServer, TTaskServer, TProcessPoolServer, serve
+export TSimpleServer, TTaskServer, TProcessPoolServer, TThreadPoolServer, serve, pipelined
 
-function generate(idl_file::String; dir::String=pwd())
+function generate(idl_file::String; dir::String=pwd(), options::String="")
+    gen = isempty(options) ? "jl" : "jl:$options"
     thrift() do thrift_cmd
-        run(Cmd(`$thrift_cmd -gen jl $idl_file`; dir=dir))
+        run(Cmd(`$thrift_cmd -gen $gen $idl_file`; dir=dir))
     end
 end
 
@@ -49,7 +63,11 @@ include("codec.jl")
 include("sasl.jl")
 include("transports.jl")
 include("protocols.jl")
+include("recordio.jl")
+include("lazy.jl")
+include("metrics.jl")
 include("processor.jl")
+include("client.jl")
 include("server.jl")
 include("utils.jl")
 
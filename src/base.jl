@@ -9,7 +9,29 @@ const TI32      = Int32
 const TI64      = Int64
 const TBINARY   = Vector{UInt8}
 const TUTF8     = String
-const TSTRING   = Union{TUTF8, TBINARY}
+
+"""
+A `binary` value read without copying, as a view into the frame it was read from.
+Generated with the `binary_views` generator option. Views are read without copying from
+framed and header transports, and remain valid after subsequent frames are read. Other
+transports copy the bytes into a new array.
+"""
+struct TBinaryView <: AbstractVector{UInt8}
+    data::Vector{UInt8}
+    offset::Int     # index of the first byte in data, less one
+    len::Int
+end
+TBinaryView(data::Vector{UInt8}) = TBinaryView(data, 0, length(data))
+Base.size(v::TBinaryView) = (v.len,)
+Base.IndexStyle(::Type{TBinaryView}) = IndexLinear()
+@inline function Base.getindex(v::TBinaryView, i::Int)
+    @boundscheck checkbounds(v, i)
+    @inbounds v.data[v.offset + i]
+end
+Base.pointer(v::TBinaryView, i::Integer=1) = pointer(v.data, v.offset + i)
+Base.convert(::Type{TBinaryView}, v::AbstractVector{UInt8}) = TBinaryView(convert(Vector{UInt8}, v))
+
+const TSTRING   = Union{TUTF8, TBINARY, TBinaryView}
 const TSTRUCT   = Any
 const TMAP      = Dict
 const TSET      = Set
@@ -17,6 +39,10 @@ const TLIST     = Array
 
 abstract type TMsg end
 
+# Messages generated with `-gen jl:typed_fields` hold each field in a concretely typed
+# `Union{Nothing,T}` Julia field instead of the `values` Dict. Unset fields are `nothing`.
+abstract type TTypedMsg <: TMsg end
+
 struct _enum_TTypes
     STOP::Int32
     VOID::Int32
@@ -44,6 +70,7 @@ julia_type(typ::Integer) = _TJTypes[typ+1]
 function julia_type(typ::Integer, narrow_typ)
     wide_typ = julia_type(typ)
     (narrow_typ <: wide_typ) && (return narrow_typ)
+    ((narrow_typ <: Enum) && (wide_typ === TI32)) && (return narrow_typ)
     error("Can not resolve type. $narrow_typ is not a subtype of $wide_typ")
 end
 
@@ -58,7 +85,9 @@ thrift_type(::Type{TI64})                 = Int32(10)
 thrift_type(::Type{TSTRING})              = Int32(11)
 thrift_type(::Type{TUTF8})                = Int32(11)
 thrift_type(::Type{TBINARY})              = Int32(11)
+thrift_type(::Type{TBinaryView})          = Int32(11)
 thrift_type(::Type{T}) where {T<:AbstractString} = Int32(11)
+thrift_type(::Type{T}) where {T<:Enum}           = Int32(8)
 thrift_type(::Type{T}) where {T<:Any}            = Int32(12)
 thrift_type(::Type{T}) where {T<:Dict}           = Int32(13)
 thrift_type(::Type{T}) where {T<:Set}            = Int32(14)
@@ -99,12 +128,30 @@ for _typ in _plain_types
     @eval begin
         write(p::TProtocol, val::$(_typ)) = 0
         read(p::TProtocol, ::Type{$(_typ)}) = nothing
-        skip(p::TProtocol, ::Type{$(_typ)}) = read(p, $(_typ))
     end
+    (_typ <: TSTRING) || @eval skip(p::TProtocol, ::Type{$(_typ)}) = read(p, $(_typ))
+end
+# strings and binaries are skipped over using their length, without reading them
+# (TSTRING = Union{String, Vector{UInt8}, TBinaryView} needs its own method as well)
+for _typ in (TUTF8, TBINARY, TBinaryView, TSTRING)
+    @eval skip(p::TProtocol, ::Type{$(_typ)}) = skip_binary(p)
+end
+skip_binary(p::TProtocol) = (read(p, TBINARY); nothing)
+
+# Enums generated with the `typed_enums` option are written as their Int32 values.
+write(p::TProtocol, val::Enum) = write(p, Int32(val))
+read(p::TProtocol, ::Type{T}) where {T<:Enum} = T(read(p, TI32))
+skip(p::TProtocol, ::Type{T}) where {T<:Enum} = skip(p, TI32)
+
+# Size in bytes of values of thrift type `ttype`, if the protocol encodes them with a fixed width, else 0.
+# Lists, sets and maps of such values are skipped over and sized in one go.
+fixed_width(p::TProtocol, ttype::Integer) = fixed_width(typeof(p), ttype)
+fixed_width(::Type{<:TProtocol}, ttype::Integer) = 0
+
+# Binary views are written by protocols the same way as Vector{UInt8}, without copying them first.
+function write(p::TProtocol, v::TBinaryView, framed::Bool=true)
+    GC.@preserve v write(p, unsafe_wrap(Array, pointer(v), v.len), framed)
 end
-# TSTRING = Union{String, Vector{UInt8}} needs its own skip method;
-# the concrete String and Vector{UInt8} methods above don't cover the Union.
-skip(p::TProtocol, ::Type{TSTRING}) = read(p, TBINARY)
 
 writeMessageBegin(p::TProtocol, name::AbstractString, mtype::Int32, seqid::Integer)     = nothing
 writeMessageEnd(p::TProtocol)                                                           = nothing
@@ -149,6 +196,15 @@ readDouble(p::TProtocol)           = read(p, TDOUBLE)
 readString(p::TProtocol)           = read(p, TUTF8)
 readBinary(p::TProtocol)           = read(p, TBINARY)
 
+# skip over a value of thrift type `ttype`, as read from a field, list, set or map header
+function skip_value(p::TProtocol, ttype::Integer)
+    if iscontainer(ttype)
+        skip_container(p, julia_type(ttype))
+    else
+        skip(p, julia_type(ttype))
+    end
+end
+
 skip(p::TProtocol, ::Type{T}) where {T<:TSTRUCT} = skip_container(p, T)
 function skip_container(p::TProtocol, ::Type{T}) where T<:TSTRUCT
     @debug("skip TSTRUCT")
@@ -156,18 +212,24 @@ function skip_container(p::TProtocol, ::Type{T}) where T<:TSTRUCT
     while true
         (name, ttype, id) = readFieldBegin(p)
         (ttype == TType.STOP) && break
-        if iscontainer(ttype)
-            skip_container(p, julia_type(ttype))
-        else
-            skip(p, julia_type(ttype))
-        end
+        skip_value(p, ttype)
         readFieldEnd(p)
     end
     readStructEnd(p)
     return
 end
 
-read(p::TProtocol, ::Type{T}) where {T<:TSTRUCT} = read(p, T())
+"""
+    read(p::TProtocol, T; fields=nothing, lazy=false)
+
+Read a struct of type `T`. If `fields` (a collection of field names) is given, only those fields are
+decoded and the others are skipped. If `lazy` is set, a `TLazyStruct{T}` is returned that decodes
+fields when they are accessed.
+"""
+function read(p::TProtocol, ::Type{T}; fields=nothing, lazy::Bool=false) where {T<:TSTRUCT}
+    lazy && return read_lazy(p, T)
+    (fields === nothing) ? read(p, T()) : read_projected(p, T(), fields)
+end
 read_container(p::TProtocol, ::Type{T}) where {T<:TSTRUCT} = read_container(p, T())
 read(p::TProtocol, val::T) where {T<:TSTRUCT} = read_container(p, val)
 function read_container(p::TProtocol, val::T) where T<:TSTRUCT
@@ -181,13 +243,19 @@ function read_container(p::TProtocol, val::T) where T<:TSTRUCT
         (name, ttyp, id) = readFieldBegin(p)
         (ttyp == TType.STOP) && break
 
-        attribs = m.numdict[Int(id)]
+        attribs = get(m.numdict, Int(id), nothing)
+        if (attribs === nothing) || (attribs.ttyp != ttyp)
+            @debug("skipping unknown field", id, ttyp)
+            skip_value(p, ttyp)
+            readFieldEnd(p)
+            continue
+        end
         jtyp = julia_type(attribs)
         fldname = attribs.fld
         if iscontainer(ttyp)
-            if isdefined(val, fldname)
+            if hasproperty(val, fldname)
                 @debug("reading into already defined container field", jtyp, fldname)
-                read_container(p, getfield(val, fldname))
+                read_container(p, getproperty(val, fldname))
             else
                 @debug("setting into container field", jtyp, fldname)
                 setproperty!(val, fldname, read_container(p, jtyp))
@@ -204,18 +272,21 @@ function read_container(p::TProtocol, val::T) where T<:TSTRUCT
     setdefaultproperties!(val)
 end
 
+# Generated structs have their own methods that set defaults from literals.
 function setdefaultproperties!(val::T) where T<:TSTRUCT
     m = meta(T)
     for attrib in m.ordered
         fldname = attrib.fld
         if !hasproperty(val, fldname) && !isempty(attrib.default)
-            default = attrib.default[1]
-            setproperty!(val, fldname, deepcopy(default))
+            setproperty!(val, fldname, default_value(attrib.default[1]))
         end
     end
     val
 end
 
+# defaults of immutable types are shared, others are copied for each struct
+default_value(default) = (isbits(default) || isa(default, String)) ? default : deepcopy(default)
+
 write(p::TProtocol, val::T) where {T<:TSTRUCT} = write_container(p, val)
 function write_container(p::TProtocol, val::T) where T<:TSTRUCT
     m = meta(T)
@@ -248,11 +319,17 @@ function skip_container(p::TProtocol, ::Type{T}) where T<:TMAP
     @debug("skip TMAP", T)
     (ktype, vtype, size) = readMapBegin(p)
     if size > 0
-        jktype = julia_type(ktype)
-        jvtype = julia_type(vtype)
-        for i in 1:size
-            skip(p, jktype)
-            skip(p, jvtype)
+        kwidth = fixed_width(p, ktype)
+        vwidth = fixed_width(p, vtype)
+        if (kwidth > 0) && (vwidth > 0)
+            skip(p.t, size * (kwidth + vwidth))
+        else
+            jktype = julia_type(ktype)
+            jvtype = julia_type(vtype)
+            for i in 1:size
+                skip(p, jktype)
+                skip(p, jvtype)
+            end
         end
     end
     readMapEnd(p)
@@ -305,12 +382,7 @@ skip(p::TProtocol, ::Type{T}) where {T<:TSET} = skip_container(p, T)
 function skip_container(p::TProtocol, ::Type{T}) where T<:TSET
     @debug("skip TSET", T)
     (etype, size) = readSetBegin(p)
-    if size > 0
-        jetype = julia_type(etype)
-        for i in 1:size
-            skip(p, jetype)
-        end
-    end
+    skip_values(p, etype, size)
     readSetEnd(p)
 end
 
@@ -356,13 +428,23 @@ skip(p::TProtocol, ::Type{T}) where {T<:TLIST} = skip_container(p, T)
 function skip_container(p::TProtocol, ::Type{T}) where T<:TLIST
     @debug("skip TLIST", T)
     (etype, size) = readListBegin(p)
-    if size > 0
+    skip_values(p, etype, size)
+    readListEnd(p)
+end
+
+# skip over the elements of a list or set
+function skip_values(p::TProtocol, etype::Integer, size::Integer)
+    (size > 0) || return
+    width = fixed_width(p, etype)
+    if width > 0
+        skip(p.t, size * width)
+    else
         jetype = julia_type(etype)
         for i in 1:size
             skip(p, jetype)
         end
     end
-    readListEnd(p)
+    nothing
 end
 
 read(p::TProtocol, ::Type{T}) where {T<:TLIST} = read(p, T())
@@ -372,19 +454,33 @@ function read_container(p::TProtocol, val::T) where T<:TLIST
     (etype, size) = readListBegin(p)
     if size > 0
         jetype = julia_type(etype, eltype(val))
-        for i in 1:size
-            push!(val, read(p, jetype))
-        end
+        read_list_values!(p, val, jetype, size)
     end
     readListEnd(p)
     val
 end
 
+# Protocols specialize this to decode lists of fixed width primitives in bulk.
+function read_list_values!(p::TProtocol, val, jetype, size::Integer)
+    for i in 1:size
+        push!(val, read(p, jetype))
+    end
+    val
+end
+
 write(p::TProtocol, val::TLIST) = write_container(p, val)
 function write_container(p::TProtocol, val::TLIST)
     @debug("write TLIST", valtype=typeof(val), size=length(val))
     etype = eltype(val)
     writeListBegin(p, thrift_type(etype), length(val))
+    write_list_values(p, val)
+    writeListEnd(p)
+    nothing
+end
+
+# Protocols specialize this to encode lists of fixed width primitives in bulk.
+function write_list_values(p::TProtocol, val)
+    etype = eltype(val)
     # TODO: need meta to convert type correctly
     for v in val
         if etype === Vector{UInt8}
@@ -393,11 +489,75 @@ function write_container(p::TProtocol, val::TLIST)
             write(p, v)
         end
     end
-    writeListEnd(p)
     nothing
 end
 
 
+##
+# Serialized sizes
+
+"""
+    serialized_size(P::Type{<:TProtocol}, val)
+    serialized_size(p::TProtocol, val)
+
+Number of bytes `val` is encoded into by the binary or compact protocol, not including a message header.
+Computed from the metadata of structs, without encoding them.
+"""
+serialized_size(p::TProtocol, val) = serialized_size(typeof(p), val)
+
+function serialized_size(::Type{P}, val::T) where {P<:TProtocol,T<:TSTRUCT}
+    m = meta(T)
+    nbyt = 1                        # field stop
+    last_fid = 0
+    for attrib in m.ordered
+        fldname = attrib.fld
+        hasproperty(val, fldname) || continue
+        nbyt += field_header_size(P, attrib.fldnum, last_fid)
+        nbyt += (attrib.ttyp == TType.BOOL) ? bool_field_size(P) : serialized_size(P, getproperty(val, fldname))
+        last_fid = attrib.fldnum
+    end
+    nbyt
+end
+serialized_size(::Type{P}, val::TMAP) where {P<:TProtocol} = map_header_size(P, length(val)) + _values_size(P, keys(val)) + _values_size(P, values(val))
+serialized_size(::Type{P}, val::Union{TSET,TLIST}) where {P<:TProtocol} = collection_header_size(P, length(val)) + _values_size(P, val)
+serialized_size(::Type{P}, val::Enum) where {P<:TProtocol} = serialized_size(P, Int32(val))
+
+function _values_size(::Type{P}, vals) where {P<:TProtocol}
+    width = fixed_width(P, thrift_type(eltype(vals)))
+    (width > 0) && (return width * length(vals))
+    nbyt = 0
+    for v in vals
+        nbyt += serialized_size(P, v)
+    end
+    nbyt
+end
+
+"""
+    reserve!(p::TProtocol, val)
+    reserve!(p::TProtocol, name::AbstractString, seqid::Integer, val)
+
+Make room in the write buffer of the protocol's transport for `val`, or for a message named `name`
+with `val` as its body, to be written without growing it.
+"""
+reserve!(p::TProtocol, val) = nothing
+reserve!(p::TProtocol, name::AbstractString, seqid::Integer, val) = nothing
+
+"""
+    reserve!(t::TTransport, nbytes::Integer)
+
+Make room for `nbytes` more bytes in the write buffer of a buffered transport. Other transports ignore this.
+"""
+reserve!(t::TTransport, nbytes::Integer) = nothing
+
+"""
+    wants_reserve(t::TTransport)
+
+Whether `reserve!` on the transport can make room for what is written next. Protocols size a value
+for `reserve!` only when it can, as sizing walks the whole value.
+"""
+wants_reserve(t::TTransport) = false
+
+
 ##
 # Thrift Structure Metadata
 
@@ -435,7 +595,30 @@ end
 
 julia_type(fattr::ThriftMetaAttribs) = fattr.jtype
 
-meta(typ::Type) = meta(typ, Symbol[], Type[], Symbol[], Int[], Dict{Symbol,Any}())
+# Metadata of types that do not have generated metadata (element types of containers, mostly).
+# These are built once per type, as they are looked up for every such field of every struct.
+# Lookups do not lock. The cache is copied on insert (which happens once per type), and the
+# copy replaces the one readers see.
+const _meta_cache = Ref(Dict{Type,ThriftMeta}())
+const _meta_cache_lock = ReentrantLock()
+function meta(typ::Type)
+    m = get(_meta_cache[], typ, nothing)
+    (m === nothing) || return m
+    lock(_meta_cache_lock)
+    try
+        cache = _meta_cache[]
+        m = get(cache, typ, nothing)
+        if m === nothing
+            m = meta(typ, Symbol[], Type[], Symbol[], Int[], Dict{Symbol,Any}())
+            cache = copy(cache)
+            cache[typ] = m
+            _meta_cache[] = cache
+        end
+        m
+    finally
+        unlock(_meta_cache_lock)
+    end
+end
 function meta(typ::Type, names::Vector{Symbol}, types::Vector{Type}, optional::Vector{Symbol}, numbers::Vector{Int}, defaults::Dict{Symbol,Any})
     m = ThriftMeta(typ, ThriftMetaAttribs[])
 
@@ -475,11 +658,10 @@ end
 @deprecate fillunset(obj) clear(obj)
 @deprecate isfilled(obj, fld) hasproperty(obj, fld)
 function isfilled(obj)
-    fill = keys(obj.values)
     flds = obj.meta.ordered
     for fld in flds
         if fld.required
-            (fld.fld in fill) || (return false)
+            hasproperty(obj, fld.fld) || (return false)
             !isempty(fld.elmeta) && !isfilled(getproperty(obj, fld.fld)) && (return false)
         end
     end
@@ -529,19 +711,75 @@ function clear(obj::TMsg, fld::Symbol)
     nothing
 end
 
+hasproperty(obj::TTypedMsg, fld::Symbol) = haskey(obj.meta.symdict, fld) && (getfield(obj, fld) !== nothing)
+function setproperty!(obj::TTypedMsg, fld::Symbol, val)
+    symdict = obj.meta.symdict
+    if fld in keys(symdict)
+        fldtype = symdict[fld].jtype
+        setfield!(obj, fld, isa(val, fldtype) ? val : convert(fldtype, val))
+    else
+        setfield!(obj, fld, val)
+    end
+end
+
+function clear(obj::TTypedMsg)
+    for attrib in obj.meta.ordered
+        setfield!(obj, attrib.fld, nothing)
+    end
+    nothing
+end
+
+function clear(obj::TTypedMsg, fld::Symbol)
+    setfield!(obj, fld, nothing)
+    nothing
+end
+
+# used by the generated `getproperty` of typed messages; throws a `KeyError` like the Dict backed ones when unset
+@inline function fieldvalue(obj::TTypedMsg, fld::Symbol)
+    val = getfield(obj, fld)
+    (val === nothing) && throw(KeyError(fld))
+    val
+end
+
 function thriftbuild(::Type{T}, nv::Dict{Symbol}=Dict{Symbol,Any}()) where T
     Base.depwarn("thriftbuild is deprecated; use constructor instead", :thriftbuild)
     T(; nv...)
 end
 
-function enumstr(enumname, t::Int32)
+# Names of the values of an enum struct. Generated enums have a table of names, those of other enum structs
+# are found with reflection once per type. Lookups do not lock, the cache is copied on insert like `_meta_cache`.
+const _enumnames_cache = Ref(Dict{DataType,Dict{Int32,String}}())
+const _enumnames_cache_lock = ReentrantLock()
+function enumnames(enumname)
     T = typeof(enumname)
-    for name in fieldnames(T)
-        (getfield(enumname, name) == t) && (return string(name))
+    names = get(_enumnames_cache[], T, nothing)
+    (names === nothing) || return names
+    lock(_enumnames_cache_lock)
+    try
+        cache = _enumnames_cache[]
+        names = get(cache, T, nothing)
+        if names === nothing
+            names = Dict{Int32,String}()
+            for name in reverse(fieldnames(T))
+                names[getfield(enumname, name)] = string(name)
+            end
+            cache = copy(cache)
+            cache[T] = names
+            _enumnames_cache[] = cache
+        end
+        names
+    finally
+        unlock(_enumnames_cache_lock)
     end
-    error("Invalid enum value $t for $T)")
 end
 
+function enumstr(enumname, t::Int32)
+    names = enumnames(enumname)
+    haskey(names, t) || error("Invalid enum value $t for $(typeof(enumname)))")
+    names[t]
+end
+enumstr(enumname, t::Enum) = string(Symbol(t))
+
 
 ##
 # Exception types
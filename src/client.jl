@@ -0,0 +1,351 @@
+##
+# Pipelined client connection, shared by async clients.
+#
+# Any number of tasks can make calls on the connection concurrently. Requests are written
+# as soon as they are made, without waiting for replies to earlier requests. Replies are
+# read by a reader task and handed to the caller waiting on the matching sequence id.
+# Requests and replies go through separate protocols over the transport, as protocols keep
+# state while reading or writing a message, and the reader may be in the middle of a reply
+# when a request is written.
+# The reader task runs only while there are calls awaiting replies, so the connection can
+# be used by a synchronous client once all calls have completed.
+#
+# If writing a request or reading a reply fails, the connection is left in an unknown state.
+# All calls awaiting replies then fail with the error, and the transport is closed. Later
+# calls throw the same error, so a new connection must be made to continue.
+
+mutable struct ThriftAsyncConnection
+    inp::TProtocol                              # reads replies
+    outp::TProtocol                             # writes requests
+    seqid::Int32
+    wlock::ReentrantLock                        # serializes writing of requests
+    plock::ReentrantLock                        # guards pending and reading
+    pending::Dict{Int32,Tuple{Any,Channel{Any}}}  # seqid => (result struct to read into, channel to complete)
+    reading::Bool
+    err::Any                                    # error the connection failed with, `nothing` till then
+
+    ThriftAsyncConnection(inp::TProtocol, outp::TProtocol) = new(inp, outp, 0, ReentrantLock(), ReentrantLock(), Dict{Int32,Tuple{Any,Channel{Any}}}(), false, nothing)
+end
+
+"""
+    ThriftAsyncConnection(inp::TProtocol, outp::TProtocol)
+    ThriftAsyncConnection(p::TProtocol)
+
+Pipelined connection that reads replies with `inp` and writes requests with `outp`, both over the same
+transport. With a single protocol, a protocol of the same kind is made over its transport to write requests.
+"""
+ThriftAsyncConnection(p::TProtocol) = ThriftAsyncConnection(p, _request_protocol(p))
+
+# a protocol like `p` over the same transport, to write requests while replies are read with `p`
+_request_protocol(p::TBinaryProtocol) = TBinaryProtocol(p.t, p.strict_read, p.strict_write)
+_request_protocol(p::TCompactProtocol) = TCompactProtocol(p.t)
+_request_protocol(p::THeaderProtocol) = THeaderProtocol(p.t, _request_protocol(p.proto))
+_request_protocol(p::TProtocol) = throw(ArgumentError("pass separate protocols to read replies and write requests with $(typeof(p))"))
+
+"""
+    call(c::ThriftAsyncConnection, name, mtype, args, result)
+
+Send a request and return a `Channel` that will have the reply put into it. `result` is an empty
+result struct to read the reply into. The channel receives either the result struct or the
+exception the call failed with. For oneway calls `result` must be `nothing`, and no channel
+is returned.
+"""
+function call(c::ThriftAsyncConnection, name::String, mtype::Int32, args, result)
+    ch = (result === nothing) ? nothing : Channel{Any}(1)
+    lock(c.wlock)
+    try
+        (c.err === nothing) || throw(c.err)
+        c.seqid = (c.seqid < (2^31-1)) ? (c.seqid+1) : 0
+        seqid = c.seqid
+        (ch === nothing) || _await_reply(c, seqid, result, ch)
+        writeMessageBegin(c.outp, name, mtype, seqid)
+        write(c.outp, args)
+        writeMessageEnd(c.outp)
+        flush(c.outp.t)
+    catch ex
+        # a request may have been written in part, replies that follow can not be trusted
+        (ex === c.err) || _fail_pending(c, ex)
+        rethrow()
+    finally
+        unlock(c.wlock)
+    end
+    ch
+end
+
+"""
+    reply(ch::Channel)
+
+Wait for the reply to a call made with `call`. Returns the result struct, or throws the exception
+the call failed with.
+"""
+function reply(ch::Channel)
+    res = take!(ch)
+    (isa(res, Exception) || isa(res, TApplicationException)) && throw(res)
+    res
+end
+
+function _await_reply(c::ThriftAsyncConnection, seqid::Int32, result, ch::Channel{Any})
+    lock(c.plock)
+    try
+        c.pending[seqid] = (result, ch)
+        if !c.reading
+            c.reading = true
+            @async _read_replies(c)
+        end
+    finally
+        unlock(c.plock)
+    end
+    nothing
+end
+
+function _read_replies(c::ThriftAsyncConnection)
+    try
+        while true
+            lock(c.plock)
+            try
+                if isempty(c.pending)
+                    c.reading = false
+                    return
+                end
+            finally
+                unlock(c.plock)
+            end
+
+            (fname, mtype, rseqid) = readMessageBegin(c.inp)
+            lock(c.plock)
+            entry = try
+                pop!(c.pending, rseqid, nothing)
+            finally
+                unlock(c.plock)
+            end
+            (entry === nothing) && throw(TApplicationException(; typ=ApplicationExceptionType.BAD_SEQUENCE_ID, message="no request waiting for response sequence id $rseqid"))
+
+            (result, ch) = entry
+            res = (mtype == MessageType.EXCEPTION) ? read(c.inp, TApplicationException()) : read(c.inp, result)
+            readMessageEnd(c.inp)
+            put!(ch, res)
+        end
+    catch ex
+        @debug("async client reader failed", exception=(ex, catch_backtrace()))
+        _fail_pending(c, ex)
+    end
+end
+
+function _fail_pending(c::ThriftAsyncConnection, ex)
+    lock(c.plock)
+    try
+        (c.err === nothing) && (c.err = ex)
+        c.reading = false
+        for (result, ch) in values(c.pending)
+            put!(ch, ex)
+        end
+        empty!(c.pending)
+    finally
+        unlock(c.plock)
+    end
+    try
+        close(c.inp.t)
+    catch cex
+        @debug("could not close failed async connection", exception=cex)
+    end
+    nothing
+end
+
+##
+# Client connection pool.
+#
+# Holds open connections to a set of endpoints, each with a client made over it. A connection is handed
+# out to one task at a time with `withclient`, from the endpoint that has the least connections handed
+# out among those that have one available. Connections that fail are closed, and are replaced by a
+# background task that reconnects to the endpoint, backing off while it can not be reached.
+
+mutable struct PooledConnection{C}
+    endpoint::Int
+    transport::TTransport
+    client::C
+end
+
+"""
+    ThriftClientPool(C, endpoints; size=4, transport=TFramedTransport, protocol=TBinaryProtocol, reconnect_delay=1.0, acquire_timeout=30.0)
+
+Pool of clients of type `C` (a generated `<Service>Client` type), with `size` connections to each of
+`endpoints`, a list of `(host, port)` tuples. Each connection is a `TSocket` wrapped with `transport`,
+and the client is made as `C(protocol(transport))`. Endpoints that can not be connected to are retried
+in the background, after `reconnect_delay` seconds at first and less frequently after repeated failures.
+Getting a client fails right away when no endpoint has a connection, and fails after waiting for
+`acquire_timeout` seconds when all connections are in use.
+
+Use `withclient` to make calls with a client from the pool, and `close` to close all connections.
+"""
+mutable struct ThriftClientPool{C}
+    endpoints::Vector{Tuple{String,Int}}
+    size::Int
+    transport                                   # makes a transport over a TSocket
+    protocol                                    # makes a protocol over the transport
+    reconnect_delay::Float64
+    acquire_timeout::Float64
+    cond::Threads.Condition                     # guards the fields below, notified when a connection is released or added
+    idle::Vector{Vector{PooledConnection{C}}}   # connections available, by endpoint
+    outstanding::Vector{Int}                    # connections handed out, by endpoint
+    next::Int                                   # endpoint to look at first, rotated to spread ties
+    closed::Bool
+end
+
+function ThriftClientPool(::Type{C}, endpoints; size::Integer=4, transport=TFramedTransport, protocol=TBinaryProtocol, reconnect_delay::Real=1.0, acquire_timeout::Real=30.0) where C
+    eps = Tuple{String,Int}[(String(host), Int(port)) for (host, port) in endpoints]
+    isempty(eps) && throw(ArgumentError("no endpoints for client pool"))
+    n = length(eps)
+    pool = ThriftClientPool{C}(eps, size, transport, protocol, reconnect_delay, acquire_timeout, Threads.Condition(), [PooledConnection{C}[] for idx in 1:n], zeros(Int, n), 1, false)
+    for idx in 1:n, conn in 1:size
+        _add_connection(pool, idx)
+    end
+    pool
+end
+
+function _connect(pool::ThriftClientPool{C}, idx::Int) where C
+    (host, port) = pool.endpoints[idx]
+    t = pool.transport(TSocket(host, port))
+    open(t)
+    PooledConnection{C}(idx, t, C(pool.protocol(t)))
+end
+
+# connect to endpoint `idx`, or start reconnecting in the background if it fails
+function _add_connection(pool::ThriftClientPool, idx::Int)
+    conn = try
+        _connect(pool, idx)
+    catch ex
+        @debug("client pool could not connect", endpoint=pool.endpoints[idx], exception=ex)
+        _reconnect(pool, idx)
+        return
+    end
+    _release(pool, conn, true, false)
+end
+
+function _reconnect(pool::ThriftClientPool, idx::Int)
+    @async begin
+        delay = pool.reconnect_delay
+        while !pool.closed
+            sleep(delay)
+            pool.closed && break
+            try
+                conn = _connect(pool, idx)
+                _release(pool, conn, true, false)
+                break
+            catch ex
+                @debug("client pool could not reconnect", endpoint=pool.endpoints[idx], exception=ex)
+                delay = min(2 * delay, 30.0)
+            end
+        end
+    end
+    nothing
+end
+
+function _acquire(pool::ThriftClientPool)
+    timer = nothing
+    expired = Ref(false)
+    lock(pool.cond)
+    try
+        while true
+            pool.closed && throw(TTransportException(TransportExceptionTypes.NOT_OPEN, "client pool is closed"))
+            n = length(pool.endpoints)
+            best = 0
+            for offset in 0:(n-1)
+                idx = mod1(pool.next + offset, n)
+                isempty(pool.idle[idx]) && continue
+                ((best == 0) || (pool.outstanding[idx] < pool.outstanding[best])) && (best = idx)
+            end
+            if best > 0
+                pool.next = mod1(best + 1, n)
+                pool.outstanding[best] += 1
+                return pop!(pool.idle[best])
+            end
+            # none will be released while all endpoints are being reconnected to
+            all(iszero, pool.outstanding) && throw(TTransportException(TransportExceptionTypes.NOT_OPEN, "no connection to any endpoint of client pool"))
+            expired[] && throw(TTransportException(TransportExceptionTypes.TIMED_OUT, "timed out waiting for a connection from client pool"))
+            if timer === nothing
+                timer = Timer(pool.acquire_timeout) do _
+                    lock(pool.cond)
+                    try
+                        expired[] = true
+                        notify(pool.cond; all=true)
+                    finally
+                        unlock(pool.cond)
+                    end
+                end
+            end
+            wait(pool.cond)
+        end
+    finally
+        unlock(pool.cond)
+        (timer === nothing) || close(timer)
+    end
+end
+
+# return a connection to the pool, or close and replace it if it is not usable
+function _release(pool::ThriftClientPool, conn::PooledConnection, usable::Bool, outstanding::Bool=true)
+    lock(pool.cond)
+    keep = usable && !pool.closed
+    try
+        outstanding && (pool.outstanding[conn.endpoint] -= 1)
+        keep && push!(pool.idle[conn.endpoint], conn)
+        notify(pool.cond)
+    finally
+        unlock(pool.cond)
+    end
+    if !keep
+        try
+            close(conn.transport)
+        catch ex
+            @debug("client pool could not close connection", exception=ex)
+        end
+        (usable || pool.closed) || _reconnect(pool, conn.endpoint)
+    end
+    nothing
+end
+
+# Exceptions declared by the service and application exceptions sent by the server are read in full and
+# leave the connection usable. After other errors, including application exceptions raised by the client
+# on a reply it did not expect, the state of the connection is not known.
+const _server_exception_types = (ApplicationExceptionType.UNKNOWN, ApplicationExceptionType.UNKNOWN_METHOD, ApplicationExceptionType.INTERNAL_ERROR,
+    ApplicationExceptionType.PROTOCOL_ERROR, ApplicationExceptionType.INVALID_TRANSFORM, ApplicationExceptionType.INVALID_PROTOCOL,
+    ApplicationExceptionType.UNSUPPORTED_CLIENT_TYPE)
+_usable_after(ex::TApplicationException) = hasproperty(ex, :typ) && (ex.typ in _server_exception_types)
+_usable_after(ex::TMsg) = true
+_usable_after(ex) = false
+
+"""
+    withclient(f, pool::ThriftClientPool)
+
+Call `f` with a client from the pool, and return what `f` returns. The client's connection is not
+used by other tasks till `f` returns. If `f` throws an error other than an exception declared by the
+service or sent by the server, the connection is closed and replaced.
+"""
+function withclient(f, pool::ThriftClientPool)
+    conn = _acquire(pool)
+    usable = true
+    try
+        return f(conn.client)
+    catch ex
+        usable = _usable_after(ex)
+        rethrow()
+    finally
+        _release(pool, conn, usable)
+    end
+end
+
+function close(pool::ThriftClientPool)
+    lock(pool.cond)
+    conns = PooledConnection[]
+    try
+        pool.closed = true
+        foreach(idle->append!(conns, idle), pool.idle)
+        foreach(empty!, pool.idle)
+        notify(pool.cond; all=true)
+    finally
+        unlock(pool.cond)
+    end
+    for conn in conns
+        close(conn.transport)
+    end
+    nothing
+end
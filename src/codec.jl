@@ -4,54 +4,127 @@ const MASK8 = 0xff
 
 const TIO = Union{IO, TTransport}
 
-function _write_fixed(io::TIO, ux::T, bigendian::Bool) where T <: Unsigned
-    N = sizeof(ux)
-    _write_fixed(io, ux, bigendian ? (N:-1:1) : (1:N))
+const TFixedWidth = Union{UInt16, UInt32, UInt64}
+
+# Fixed width values are written and read with a single call on the transport.
+# Transports pass them on to their underlying IO or buffer, which avoids a temporary array per value.
+_write_fixed(io::TIO, ux::T, bigendian::Bool) where {T <: Unsigned} = write(io, bigendian ? hton(ux) : htol(ux))
+
+# fallback for transports that only know how to write bytes
+write(t::TTransport, x::TFixedWidth) = write(t, collect(reinterpret(UInt8, [x])))
+
+function _read_fixed(io::TIO, ::Type{T}, bigendian::Bool) where T <: Unsigned
+    ux = read(io, T)
+    bigendian ? ntoh(ux) : ltoh(ux)
 end
 
-function _write_fixed(io::TIO, ux::T, r::R) where {T <: Unsigned, R <: AbstractRange}
-    a = Vector{UInt8}(undef, sizeof(ux))
-    for n in r
-        a[n] = UInt8(ux & MASK8)
-        ux >>>= 8
+# Vectors of fixed width values are copied to or from the transport in one go,
+# with the byte order fixed up in place in a loop that the compiler can vectorize.
+_wire_type(::Type{T}) where {T <: Integer} = unsigned(T)
+_wire_type(::Type{Float64}) = UInt64
+
+function _read_fixed_vector!(io::TIO, dest::Vector{T}, n::Integer, bigendian::Bool) where T
+    U = _wire_type(T)
+    n0 = length(dest)
+    resize!(dest, n0 + n)
+    GC.@preserve dest begin
+        ptr = pointer(dest, n0 + 1)
+        read!(io, unsafe_wrap(Array, Ptr{UInt8}(ptr), n * sizeof(T)))
+        wire = unsafe_wrap(Array, Ptr{U}(ptr), n)
+        if bigendian
+            @inbounds @simd for i in 1:n
+                wire[i] = ntoh(wire[i])
+            end
+        else
+            @inbounds @simd for i in 1:n
+                wire[i] = ltoh(wire[i])
+            end
+        end
     end
-    write(io, a)
+    dest
 end
 
-function _read_fixed(io::TIO, ret::T, N::Int, bigendian::Bool) where T <: Unsigned
-    r = bigendian ? ((N-1):-1:0) : (0:1:(N-1))
-    for n in r
-        byte = convert(T, read(io, UInt8))
-        ret |= (byte << (8*n))
+function _write_fixed_vector(io::TIO, src::Vector{T}, bigendian::Bool) where T
+    U = _wire_type(T)
+    n = length(src)
+    wire = Vector{U}(undef, n)
+    if bigendian
+        @inbounds @simd for i in 1:n
+            wire[i] = hton(reinterpret(U, src[i]))
+        end
+    else
+        @inbounds @simd for i in 1:n
+            wire[i] = htol(reinterpret(U, src[i]))
+        end
     end
-    ret
+    GC.@preserve wire write(io, unsafe_wrap(Array, Ptr{UInt8}(pointer(wire)), n * sizeof(U)))
 end
 
+# Buffered transports expose their read and write buffers so that varints can be
+# decoded and encoded directly against the bytes, without going through the
+# transport for every byte. Others return `nothing` and take the byte-wise path.
+readbuffer(io) = nothing
+readbuffer(io::Base.GenericIOBuffer) = io
+writebuffer(io) = nothing
+writebuffer(io::Base.GenericIOBuffer) = io
+
+# A varint of up to 64 bits needs at most 10 bytes. It is packed into a UInt128
+# (first byte in the least significant position) and written out with a single write.
 function _write_uleb(io::TIO, x::T) where T <: Integer
+    packed = UInt128(0)
     nw = 0
-    cont = true
-    while cont
-        byte = x & MASK7
-        if (x >>>= 7) != 0
-            byte |= MSB
-        else
-            cont = false
+    while true
+        byte = UInt8(x & MASK7)
+        x >>>= 7
+        (x != 0) && (byte |= MSB)
+        packed |= (UInt128(byte) << (8*nw))
+        nw += 1
+        (x == 0) && break
+    end
+    _write_packed(io, packed, nw)
+end
+
+function _write_packed(io::TIO, packed::UInt128, nw::Int)
+    (nw == 1) && return write(io, UInt8(packed))
+    buf = writebuffer(io)
+    if buf === nothing
+        bytes = Vector{UInt8}(undef, nw)
+        for n in 1:nw
+            @inbounds bytes[n] = UInt8(packed & MASK8)
+            packed >>>= 8
         end
-        nw += write(io, UInt8(byte))
+        write(io, bytes)
+    else
+        unsafe_write(buf, Ref(htol(packed)), nw)
     end
     nw
 end
 
 function _read_uleb(io::TIO, typ::Type{T}) where T <: Integer
-    res = convert(typ, 0)
-    n = 0
-    byte = UInt8(MSB)
-    while (byte & MSB) != 0
+    res = zero(T)
+    shift = 0
+    buf = readbuffer(io)
+    if buf !== nothing
+        # decode straight out of the buffered bytes
+        while bytesavailable(buf) > 0
+            byte = read(buf, UInt8)
+            res |= (convert(T, byte & MASK7) << shift)
+            ((byte & MSB) == 0) && return res
+            shift += 7
+        end
+    end
+    # the varint continues beyond what is buffered (e.g. across frames)
+    _read_uleb_rest(io, res, shift)
+end
+
+# read the remaining bytes of a varint whose first bytes were decoded into `res`
+function _read_uleb_rest(io::TIO, res::T, shift::Int) where T <: Integer
+    while true
         byte = read(io, UInt8)
-        res |= (convert(typ, byte & MASK7) << (7*n))
-        n += 1
+        res |= (convert(T, byte & MASK7) << shift)
+        ((byte & MSB) == 0) && return res
+        shift += 7
     end
-    res
 end
 
 function _write_zigzag(io::TIO, x::T) where T <: Integer
@@ -60,7 +133,60 @@ function _write_zigzag(io::TIO, x::T) where T <: Integer
     _write_uleb(io, zx)
 end
 
-function _read_zigzag(io::TIO, typ::Type{T}) where T <: Integer
-    zx = convert(Int64, _read_uleb(io, UInt64))
-    convert(typ, xor((zx >>> 1), -(zx & Int64(1))))
+# number of bytes a value is encoded into
+_uleb_size(x::Unsigned) = max(1, cld(8*sizeof(x) - leading_zeros(x), 7))
+_zigzag_size(x::T) where T <: Signed = _uleb_size(unsigned(xor((x << 1), (x >> (8*sizeof(x)-1)))))
+
+function _read_zigzag(io::TIO, typ::Type{T}) where T <: Signed
+    zx = _read_uleb(io, unsigned(T))
+    reinterpret(T, xor((zx >>> 1), -(zx & one(zx))))
+end
+
+# Batched zigzag decoding for lists. Values are decoded in a single pass over the bytes in the
+# transport's read buffer; a value cut off at the end of the buffer is completed through the transport.
+function _read_zigzag_vector!(io::TIO, dest::Vector{T}, n::Integer) where T <: Signed
+    U = unsigned(T)
+    n0 = length(dest)
+    resize!(dest, n0 + n)
+    i = n0 + 1
+    last = n0 + n
+    while i <= last
+        buf = readbuffer(io)
+        if (buf === nothing) || (bytesavailable(buf) == 0)
+            @inbounds dest[i] = _read_zigzag(io, T)
+            i += 1
+            continue
+        end
+        zx = zero(U)
+        shift = 0
+        while (i <= last) && (bytesavailable(buf) > 0)
+            byte = read(buf, UInt8)
+            zx |= (convert(U, byte & MASK7) << shift)
+            if (byte & MSB) == 0
+                @inbounds dest[i] = reinterpret(T, xor((zx >>> 1), -(zx & one(zx))))
+                i += 1
+                zx = zero(U)
+                shift = 0
+            else
+                shift += 7
+            end
+        end
+        if shift > 0
+            zx = _read_uleb_rest(io, zx, shift)
+            @inbounds dest[i] = reinterpret(T, xor((zx >>> 1), -(zx & one(zx))))
+            i += 1
+        end
+    end
+    dest
+end
+
+function _write_zigzag_vector(io::TIO, src::Vector{T}) where T <: Signed
+    buf = writebuffer(io)
+    out = (buf === nothing) ? IOBuffer() : buf
+    nw = 0
+    for x in src
+        nw += _write_zigzag(out, x)
+    end
+    (buf === nothing) && write(io, take!(out))
+    nw
 end
@@ -0,0 +1,136 @@
+##
+# Partial decoding of structs.
+#
+# Projected reads decode only the requested fields of a struct and skip over the others.
+# Lazy reads keep the serialized bytes of a struct along with the offset of each field in them,
+# and decode a field only when it is first accessed.
+
+function read_projected(p::TProtocol, val::T, fields) where T<:TSTRUCT
+    @debug("read TSTRUCT projected", T, fields)
+    readStructBegin(p)
+
+    m = meta(T)
+    clear(val)
+    while true
+        (name, ttyp, id) = readFieldBegin(p)
+        (ttyp == TType.STOP) && break
+
+        attribs = get(m.numdict, Int(id), nothing)
+        if (attribs === nothing) || (attribs.ttyp != ttyp) || !(attribs.fld in fields)
+            skip_value(p, ttyp)
+        else
+            jtyp = julia_type(attribs)
+            setproperty!(val, attribs.fld, iscontainer(ttyp) ? read_container(p, jtyp) : read(p, jtyp))
+        end
+        readFieldEnd(p)
+    end
+    readStructEnd(p)
+
+    # populate defaults of the requested fields
+    for fldname in fields
+        attribs = m.symdict[fldname]
+        if !hasproperty(val, fldname) && !isempty(attribs.default)
+            setproperty!(val, fldname, default_value(attribs.default[1]))
+        end
+    end
+    val
+end
+
+# Transport that keeps a copy of the bytes read through it.
+mutable struct TTeeTransport <: TTransport
+    tp::TTransport
+    copy::IOBuffer
+    TTeeTransport(tp::TTransport) = new(tp, PipeBuffer())
+end
+rawio(t::TTeeTransport)  = rawio(t.tp)
+read!(t::TTeeTransport, buff::Vector{UInt8}) = (read!(t.tp, buff); write(t.copy, buff); buff)
+read(t::TTeeTransport, type::Type{<:Unsigned}) = (x = read(t.tp, type); write(t.copy, x); x)
+read(t::TTeeTransport, sz::Integer) = (data = read(t.tp, sz); write(t.copy, data); data)
+
+# A protocol like `p` over transport `t`, in a state to read a value.
+value_protocol(p::TBinaryProtocol, t::TTransport) = TBinaryProtocol(t, p.strict_read, p.strict_write)
+value_protocol(p::TCompactProtocol, t::TTransport) = (vp = TCompactProtocol(t); vp.state = CState.VALUE_READ; vp)
+value_protocol(p::THeaderProtocol, t::TTransport) = value_protocol(p.proto, t)
+
+"""
+    TLazyStruct{T}
+
+A struct of type `T` whose fields are decoded from its serialized bytes when first accessed.
+Obtained with `read(p, T; lazy=true)`. Fields are accessed as with `T`, but can not be set.
+When written with the protocol it was read with, the serialized bytes are written as they are.
+"""
+mutable struct TLazyStruct{T,P<:TProtocol}
+    val::T                                      # fields decoded so far
+    data::Vector{UInt8}                         # serialized struct
+    proto::P                                    # protocol to decode fields with, over a transport of the above
+    offsets::Dict{Symbol,Int}                   # fields not yet decoded => start of their value in data
+end
+
+function read_lazy(p::TProtocol, ::Type{T}) where T<:TSTRUCT
+    @debug("read TSTRUCT lazy", T)
+    tee = TTeeTransport(p.t)
+    ip = value_protocol(p, tee)
+    val = T()
+    clear(val)
+    m = meta(T)
+    offsets = Dict{Symbol,Int}()
+
+    # index the fields, while skipping over their values
+    readStructBegin(ip)
+    while true
+        (name, ttyp, id) = readFieldBegin(ip)
+        (ttyp == TType.STOP) && break
+
+        attribs = get(m.numdict, Int(id), nothing)
+        if (attribs === nothing) || (attribs.ttyp != ttyp)
+            skip_value(ip, ttyp)
+        elseif ttyp == TType.BOOL
+            # booleans may be encoded in the field header
+            setproperty!(val, attribs.fld, read(ip, Bool))
+        else
+            offsets[attribs.fld] = bytesavailable(tee.copy) + 1
+            skip_value(ip, ttyp)
+        end
+        readFieldEnd(ip)
+    end
+    readStructEnd(ip)
+    setdefaultproperties!(val)
+
+    data = take!(tee.copy)
+    TLazyStruct{T,typeof(ip)}(val, data, value_protocol(ip, TMemoryTransport(IOBuffer(data))), offsets)
+end
+
+function _decode!(l::TLazyStruct{T}, name::Symbol) where T
+    offsets = getfield(l, :offsets)
+    offset = pop!(offsets, name)
+    proto = getfield(l, :proto)
+    seek(proto.t.buff, offset - 1)
+    attribs = meta(T).symdict[name]
+    jtyp = julia_type(attribs)
+    val = iscontainer(attribs.ttyp) ? read_container(proto, jtyp) : read(proto, jtyp)
+    setproperty!(getfield(l, :val), name, val)
+    nothing
+end
+
+function getproperty(l::TLazyStruct, name::Symbol)
+    haskey(getfield(l, :offsets), name) && _decode!(l, name)
+    getproperty(getfield(l, :val), name)
+end
+hasproperty(l::TLazyStruct, name::Symbol) = haskey(getfield(l, :offsets), name) || hasproperty(getfield(l, :val), name)
+propertynames(l::TLazyStruct) = propertynames(getfield(l, :val))
+
+"""
+    materialize(l::TLazyStruct)
+
+Decode all remaining fields and return the struct.
+"""
+function materialize(l::TLazyStruct)
+    for name in collect(keys(getfield(l, :offsets)))
+        _decode!(l, name)
+    end
+    getfield(l, :val)
+end
+
+write(p::P, l::TLazyStruct{T,P}) where {T,P<:Union{TBinaryProtocol,TCompactProtocol}} = (write(p.t, getfield(l, :data)); nothing)
+write(p::THeaderProtocol, l::TLazyStruct) = write(p.proto, l)
+write(p::TProtocol, l::TLazyStruct) = write(p, materialize(l))
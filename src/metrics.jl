@@ -0,0 +1,194 @@
+##
+# Request metrics.
+#
+# Processors instrumented with `instrument` record, for each service method, the number of requests,
+# errors (declared exceptions returned to the client) and exceptions (errors not declared for the method),
+# bytes received and sent, and latency histograms for decoding the request, running the handler and
+# encoding the reply. Servers also count connections, and count bytes by wrapping accepted connections
+# in a `TMeteredTransport`.
+
+const LATENCY_BUCKETS = 32
+
+"""
+Histogram of latencies in power of two microsecond buckets. Bucket `i` counts latencies of at most
+`2^(i-1)` microseconds that are not counted in a lower bucket (as Prometheus `le` buckets do). The last
+bucket counts all larger latencies.
+"""
+mutable struct LatencyHistogram
+    counts::Vector{Int}
+    count::Int
+    sum::UInt64         # nanoseconds
+    LatencyHistogram() = new(zeros(Int, LATENCY_BUCKETS), 0, 0)
+end
+
+function observe!(h::LatencyHistogram, ns::UInt64)
+    us = max(cld(ns, UInt64(1000)), UInt64(1))
+    bits = 64 - leading_zeros(us - UInt64(1))   # 2^bits is the smallest power of two not below us
+    h.counts[min(bits + 1, LATENCY_BUCKETS)] += 1
+    h.count += 1
+    h.sum += ns
+    nothing
+end
+
+Base.copy(h::LatencyHistogram) = (c = LatencyHistogram(); copyto!(c.counts, h.counts); c.count = h.count; c.sum = h.sum; c)
+
+mutable struct MethodMetrics
+    requests::Int
+    errors::Int
+    exceptions::Int
+    bytes_in::Int
+    bytes_out::Int
+    decode::LatencyHistogram
+    handler::LatencyHistogram
+    encode::LatencyHistogram
+    MethodMetrics() = new(0, 0, 0, 0, 0, LatencyHistogram(), LatencyHistogram(), LatencyHistogram())
+end
+
+Base.copy(m::MethodMetrics) = (c = MethodMetrics(); c.requests = m.requests; c.errors = m.errors; c.exceptions = m.exceptions; c.bytes_in = m.bytes_in; c.bytes_out = m.bytes_out;
+    c.decode = copy(m.decode); c.handler = copy(m.handler); c.encode = copy(m.encode); c)
+
+"""
+    ThriftMetrics()
+
+Metrics collected by an instrumented processor (see `instrument`). Use `snapshot` to get a consistent
+copy, and `write_prometheus` to export them in the Prometheus text format.
+"""
+mutable struct ThriftMetrics
+    lock::ReentrantLock
+    methods::Dict{String,MethodMetrics}
+    connections::Int
+    active_connections::Int
+    ThriftMetrics() = new(ReentrantLock(), Dict{String,MethodMetrics}(), 0, 0)
+end
+
+function _update!(f, m::ThriftMetrics, name::String)
+    lock(m.lock)
+    try
+        f(get!(MethodMetrics, m.methods, name))
+    finally
+        unlock(m.lock)
+    end
+    nothing
+end
+
+function _connection!(m::ThriftMetrics, delta::Int)
+    lock(m.lock)
+    try
+        (delta > 0) && (m.connections += delta)
+        m.active_connections += delta
+    finally
+        unlock(m.lock)
+    end
+    nothing
+end
+
+"""
+    snapshot(m::ThriftMetrics)
+
+Return a copy of the metrics collected so far, which is not updated by further requests.
+"""
+function snapshot(m::ThriftMetrics)
+    s = ThriftMetrics()
+    lock(m.lock)
+    try
+        for (name, mm) in m.methods
+            s.methods[name] = copy(mm)
+        end
+        s.connections = m.connections
+        s.active_connections = m.active_connections
+    finally
+        unlock(m.lock)
+    end
+    s
+end
+
+"""
+    write_prometheus(io::IO, m::ThriftMetrics; prefix::String="thrift")
+
+Write a snapshot of the metrics in the Prometheus text exposition format. Latencies are in seconds.
+"""
+function write_prometheus(io::IO, m::ThriftMetrics; prefix::String="thrift")
+    s = snapshot(m)
+    names = sort!(collect(keys(s.methods)))
+
+    println(io, "# TYPE $(prefix)_connections_total counter")
+    println(io, "$(prefix)_connections_total $(s.connections)")
+    println(io, "# TYPE $(prefix)_active_connections gauge")
+    println(io, "$(prefix)_active_connections $(s.active_connections)")
+
+    for (metric, field) in (("requests_total", :requests), ("errors_total", :errors), ("exceptions_total", :exceptions), ("received_bytes_total", :bytes_in), ("sent_bytes_total", :bytes_out))
+        println(io, "# TYPE $(prefix)_$(metric) counter")
+        for name in names
+            println(io, "$(prefix)_$(metric){method=\"$(name)\"} $(getfield(s.methods[name], field))")
+        end
+    end
+
+    println(io, "# TYPE $(prefix)_latency_seconds histogram")
+    for name in names, stage in (:decode, :handler, :encode)
+        h = getfield(s.methods[name], stage)
+        labels = "method=\"$(name)\",stage=\"$(stage)\""
+        cumulative = 0
+        for idx in 1:(LATENCY_BUCKETS-1)
+            cumulative += h.counts[idx]
+            println(io, "$(prefix)_latency_seconds_bucket{$(labels),le=\"$(2.0^(idx-1) / 1e6)\"} $(cumulative)")
+        end
+        println(io, "$(prefix)_latency_seconds_bucket{$(labels),le=\"+Inf\"} $(h.count)")
+        println(io, "$(prefix)_latency_seconds_sum{$(labels)} $(h.sum / 1e9)")
+        println(io, "$(prefix)_latency_seconds_count{$(labels)} $(h.count)")
+    end
+    nothing
+end
+
+##
+# Transport that counts bytes read and written through it.
+mutable struct TMeteredTransport <: TTransport
+    tp::TTransport
+    nread::Int
+    nwritten::Int
+    lastread::Int       # nread when bytes were last attributed to a request
+    lastwritten::Int
+    TMeteredTransport(tp::TTransport) = new(tp, 0, 0, 0, 0)
+end
+rawio(t::TMeteredTransport)  = rawio(t.tp)
+open(t::TMeteredTransport)   = open(t.tp)
+close(t::TMeteredTransport)  = close(t.tp)
+isopen(t::TMeteredTransport) = isopen(t.tp)
+flush(t::TMeteredTransport)  = flush(t.tp)
+read!(t::TMeteredTransport, buff::Vector{UInt8}) = (t.nread += length(buff); read!(t.tp, buff))
+read(t::TMeteredTransport, type::Type{<:Unsigned}) = (t.nread += sizeof(type); read(t.tp, type))
+read(t::TMeteredTransport, sz::Integer) = (data = read(t.tp, sz); t.nread += length(data); data)
+skip(t::TMeteredTransport, sz::Integer) = (skip(t.tp, sz); t.nread += sz; nothing)
+write(t::TMeteredTransport, buff::Vector{UInt8}) = (t.nwritten += length(buff); write(t.tp, buff))
+write(t::TMeteredTransport, b::UInt8) = (t.nwritten += 1; write(t.tp, b))
+write(t::TMeteredTransport, x::TFixedWidth) = (t.nwritten += sizeof(x); write(t.tp, x))
+
+# the metered transport under the transports used by a protocol, if any
+_metered(p::TProtocol) = _metered(p.t)
+_metered(t::TMeteredTransport) = t
+_metered(t::TTransport) = isdefined(t, :tp) ? _metered(getfield(t, :tp)) : nothing
+_metered(x) = nothing
+
+# bytes read from the connection since the last call
+function _take_read!(p::TProtocol)
+    t = _metered(p)
+    (t === nothing) && return 0
+    n = t.nread - t.lastread
+    t.lastread = t.nread
+    n
+end
+
+# bytes written to the connection since the last call
+function _take_written!(p::TProtocol)
+    t = _metered(p)
+    (t === nothing) && return 0
+    n = t.nwritten - t.lastwritten
+    t.lastwritten = t.nwritten
+    n
+end
+
+_now(m::Nothing) = UInt64(0)
+_now(m::ThriftMetrics) = time_ns()
+
+# whether the result struct carries a declared exception
+_iserror(outstruct::TMsg) = any(fld->((fld !== :success) && hasproperty(outstruct, fld)), propertynames(outstruct))
+_iserror(outstruct) = false
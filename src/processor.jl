@@ -1,26 +1,113 @@
 ##
 # The default processor core.
 
-mutable struct ThriftHandler{I,O}
-    name::AbstractString
-    fn::Function
+# A pool of message instances of one type, cleared and reused across requests.
+mutable struct MessagePool{T}
+    lock::ReentrantLock
+    free::Vector{T}
+    maxsize::Int
+    MessagePool{T}(maxsize::Int=64) where {T} = new{T}(ReentrantLock(), T[], maxsize)
+end
+
+function acquire!(pool::MessagePool{T}) where T
+    lock(pool.lock)
+    msg = try
+        isempty(pool.free) ? nothing : pop!(pool.free)
+    finally
+        unlock(pool.lock)
+    end
+    (msg === nothing) ? T() : msg
+end
+
+function release!(pool::MessagePool{T}, msg::T) where T
+    clear(msg)
+    lock(pool.lock)
+    try
+        (length(pool.free) < pool.maxsize) && push!(pool.free, msg)
+    finally
+        unlock(pool.lock)
+    end
+    nothing
+end
+
+# Handler for a service method. `fn` is concretely typed, so calls through a handler known at
+# compile time (as in generated processors) can be inferred.
+mutable struct ThriftHandler{I,O,F}
+    name::String
+    fn::F
     intyp::Type{I}
     outtyp::Type{O}
+    inpool::MessagePool{I}
+    outpool::MessagePool{O}
+    ThriftHandler(name::AbstractString, fn::F, intyp::Type{I}, outtyp::Type{O}) where {I,O,F} = new{I,O,F}(String(name), fn, intyp, outtyp, MessagePool{I}(), MessagePool{O}())
 end
 
 mutable struct ThriftProcessor
     handlers::Dict{AbstractString, ThriftHandler}
     use_spawn::Bool
+    use_pool::Bool
+    metrics::Union{Nothing,ThriftMetrics}
     extends::ThriftProcessor
-    ThriftProcessor() = (o=new(); o.use_spawn=false; o.handlers=Dict{AbstractString, ThriftHandler}(); o)
+    ThriftProcessor() = (o=new(); o.use_spawn=false; o.use_pool=false; o.metrics=nothing; o.handlers=Dict{AbstractString, ThriftHandler}(); o)
 end
 
 handle(p::ThriftProcessor, handler::ThriftHandler) = (p.handlers[handler.name] = handler; nothing)
 extend(p::ThriftProcessor, extends::ThriftProcessor) = (setfield!(p, :extends, extends); nothing)
 distribute(p::ThriftProcessor, use_spawn::Bool=true) = (setfield!(p, :use_spawn, use_spawn); nothing)
 
+"""
+    recycle(p::ThriftProcessor, use_pool::Bool=true)
+
+Reuse argument and result messages across requests instead of allocating new ones for each request.
+Messages are taken from per-handler pools and returned to them after the reply is sent, so handlers
+must not hold on to their argument structs (the field values themselves are not reused).
+Requires generated code whose handler functions accept the result struct to fill.
+Not used along with `distribute`.
+"""
+function recycle(p::ThriftProcessor, use_pool::Bool=true)
+    setfield!(p, :use_pool, use_pool)
+    isdefined(p, :extends) && recycle(p.extends, use_pool)
+    nothing
+end
+
+"""
+    instrument(p::ThriftProcessor, m::ThriftMetrics=ThriftMetrics())
+
+Record metrics of requests handled by the processor into `m`, and return `m`. Servers also record
+connections and bytes transferred for instrumented processors. Pass `nothing` to stop recording.
+"""
+function instrument(p::ThriftProcessor, m::Union{Nothing,ThriftMetrics}=ThriftMetrics())
+    setfield!(p, :metrics, m)
+    isdefined(p, :extends) && instrument(p.extends, m)
+    m
+end
+
+metrics(p::ThriftProcessor) = p.metrics
+metrics(p::TProcessor) = nothing
+
+_readargs(p::ThriftProcessor, handler::ThriftHandler, inp::TProtocol) = p.use_pool ? read(inp, acquire!(handler.inpool)) : read(inp, handler.intyp)
+
+function _call(p::ThriftProcessor, handler::ThriftHandler{I,O}, instruct::I) where {I,O}
+    if p.use_spawn
+        fetch(@spawn handler.fn(instruct))
+    elseif p.use_pool && (O !== Nothing)
+        handler.fn(instruct, acquire!(handler.outpool))
+    else
+        handler.fn(instruct)
+    end
+end
+
+function _recycle(p::ThriftProcessor, handler::ThriftHandler{I,O}, instruct::I, outstruct) where {I,O}
+    if p.use_pool
+        release!(handler.inpool, instruct)
+        isa(outstruct, O) && (O !== Nothing) && release!(handler.outpool, outstruct)
+    end
+    nothing
+end
+
 function _reply(outp::TProtocol, name::AbstractString, seqid::Int32, mtyp::Int32, m::Any)
     @debug("_reply", name, seqid, m)
+    reserve!(outp, name, seqid, m)
     writeMessageBegin(outp, name, mtyp, seqid)
     write(outp, m)
     writeMessageEnd(outp)
@@ -30,34 +117,128 @@ end
 
 _exception(extyp::Int32, exmsg::AbstractString, outp::TProtocol, name::AbstractString, seqid::Int32) = _reply(outp, name, seqid, MessageType.EXCEPTION, TApplicationException(; typ=extyp, message=exmsg))
 
+# Look up the handler for a method name, through the chain of extended processors.
+function _handler(p::ThriftProcessor, name::AbstractString)
+    tp = p
+    while !haskey(tp.handlers, name) && isdefined(tp, :extends)
+        tp = tp.extends
+    end
+    haskey(tp.handlers, name) ? (tp, tp.handlers[name]) : (tp, nothing)
+end
+
 function process(p::ThriftProcessor, inp::TProtocol, outp::TProtocol)
     @debug("process begin")
     (name, typ, seqid) = readMessageBegin(inp)
+    (tp, handler) = _handler(p, name)
+    (handler === nothing) ? _unknown(inp, outp, name, seqid) : _process(tp, inp, outp, name, typ, seqid, handler)
+end
 
-    haskey(p.handlers, name) && (return _process(p, inp, outp, name, typ, seqid))
-
-    isdefined(p, :extends) && (return _process(p.extends, inp, outp, name, typ, seqid))
-
+function _unknown(inp::TProtocol, outp::TProtocol, name::AbstractString, seqid::Int32)
     skip(inp, TSTRUCT)
     readMessageEnd(inp)
     _exception(ApplicationExceptionType.UNKNOWN_METHOD, "Unknown function $name", outp, name, seqid)
 end
 
-function _process(p::ThriftProcessor, inp::TProtocol, outp::TProtocol, name::AbstractString, typ::Int32, seqid::Int32)
-    handler = p.handlers[name]
+function _process(p::ThriftProcessor, inp::TProtocol, outp::TProtocol, name::AbstractString, typ::Int32, seqid::Int32, handler::ThriftHandler)
+    m = p.metrics
     @debug("_process: reading instruct", type=handler.intyp)
-    instruct = read(inp, handler.intyp)
+    t0 = _now(m)
+    instruct = _readargs(p, handler, inp)
     readMessageEnd(inp)
+    t1 = _now(m)
+    bytes_in = (m === nothing) ? 0 : _take_read!(inp)
     @debug("_process: calling handler function")
-    if p.use_spawn
-        outstruct = fetch(@spawn handler.fn(instruct))
-    else
-        outstruct = handler.fn(instruct)
+    outstruct = try
+        _call(p, handler, instruct)
+    catch
+        (m === nothing) || _record_exception!(m, handler, t0, t1, _now(m), bytes_in)
+        rethrow()
     end
+    t2 = _now(m)
     @debug("_process: out of handler function", outstruct)
+    _respond(outp, handler, name, seqid, outstruct)
+    (m === nothing) || _record!(m, handler, t0, t1, t2, _now(m), bytes_in, outp, outstruct)
+    _recycle(p, handler, instruct, outstruct)
+end
+
+# `bytes_in` must be taken as soon as the request is read, as later requests may have been read by the time
+# the reply is sent (out of order processing)
+function _record!(m::ThriftMetrics, handler::ThriftHandler, t0::UInt64, t1::UInt64, t2::UInt64, t3::UInt64, bytes_in::Int, outp::TProtocol, outstruct)
+    bytes_out = _take_written!(outp)
+    iserror = _iserror(outstruct)
+    _update!(m, handler.name) do mm
+        mm.requests += 1
+        iserror && (mm.errors += 1)
+        mm.bytes_in += bytes_in
+        mm.bytes_out += bytes_out
+        observe!(mm.decode, t1 - t0)
+        observe!(mm.handler, t2 - t1)
+        observe!(mm.encode, t3 - t2)
+    end
+end
+
+function _record_exception!(m::ThriftMetrics, handler::ThriftHandler, t0::UInt64, t1::UInt64, t2::UInt64, bytes_in::Int)
+    _update!(m, handler.name) do mm
+        mm.requests += 1
+        mm.exceptions += 1
+        mm.bytes_in += bytes_in
+        observe!(mm.decode, t1 - t0)
+        observe!(mm.handler, t2 - t1)
+    end
+end
+
+function _respond(outp::TProtocol, handler::ThriftHandler, name::AbstractString, seqid::Int32, outstruct)
     if !isa(outstruct, handler.outtyp)
         _exception(ApplicationExceptionType.MISSING_RESULT, "Invalid return type. Expected $(handler.outtyp). Got $(typeof(outstruct))", outp, name, seqid)
         return
     end
     isa(outstruct, Nothing) || _reply(outp, name, seqid, MessageType.REPLY, outstruct)
 end
+
+##
+# Out of order processing.
+# The request is read and decoded by the caller, and the handler is run in a new task, spawned on any thread so
+# that handlers that do not yield do not hold up the connection either. The caller can go on to read the next
+# request while earlier ones are being handled. Replies are written as handlers complete, with `outlock` held
+# so that replies do not interleave. Returns the task handling the request, or `nothing`.
+function process(p::ThriftProcessor, inp::TProtocol, outp::TProtocol, outlock::ReentrantLock)
+    @debug("process begin")
+    (name, typ, seqid) = readMessageBegin(inp)
+    (tp, handler) = _handler(p, name)
+    (handler === nothing) ? _unknown(inp, outp, name, seqid, outlock) : _process(tp, inp, outp, name, typ, seqid, handler, outlock)
+end
+
+function _unknown(inp::TProtocol, outp::TProtocol, name::AbstractString, seqid::Int32, outlock::ReentrantLock)
+    skip(inp, TSTRUCT)
+    readMessageEnd(inp)
+    lock(outlock) do
+        _exception(ApplicationExceptionType.UNKNOWN_METHOD, "Unknown function $name", outp, name, seqid)
+    end
+    nothing
+end
+
+function _process(p::ThriftProcessor, inp::TProtocol, outp::TProtocol, name::AbstractString, typ::Int32, seqid::Int32, handler::ThriftHandler, outlock::ReentrantLock)
+    m = p.metrics
+    t0 = _now(m)
+    instruct = _readargs(p, handler, inp)
+    readMessageEnd(inp)
+    t1 = _now(m)
+    bytes_in = (m === nothing) ? 0 : _take_read!(inp)
+    Threads.@spawn begin
+        try
+            outstruct = _call(p, handler, instruct)
+            t2 = _now(m)
+            lock(outlock) do
+                _respond(outp, handler, name, seqid, outstruct)
+                (m === nothing) || _record!(m, handler, t0, t1, t2, _now(m), bytes_in, outp, outstruct)
+            end
+            _recycle(p, handler, instruct, outstruct)
+        catch ex
+            (m === nothing) || _record_exception!(m, handler, t0, t1, _now(m), bytes_in)
+            @error("exception handling request", name, seqid, exception=(ex, catch_backtrace()))
+            (handler.outtyp === Nothing) || lock(outlock) do
+                _exception(ApplicationExceptionType.INTERNAL_ERROR, "Internal error processing $name", outp, name, seqid)
+            end
+        end
+    end
+end
@@ -133,21 +133,50 @@ readListBegin(p::TBinaryProtocol) = (readByte(p), readI32(p))
 readSetBegin(p::TBinaryProtocol) = (readByte(p), readI32(p))
 
 read(p::TBinaryProtocol, ::Type{Bool})          = (0x0 != readByte(p))
-read(p::TBinaryProtocol, ::Type{TBYTE})         = _read_fixed(p.t, UInt8(0), 1, true)
+read(p::TBinaryProtocol, ::Type{TBYTE})         = _read_fixed(p.t, UInt8, true)
 
 read(p::TBinaryProtocol, ::Type{TI16})          = reinterpret(TI16, read(p, UInt16))
-read(p::TBinaryProtocol, ::Type{UInt16})        = _read_fixed(p.t, UInt16(0), 2, true)
+read(p::TBinaryProtocol, ::Type{UInt16})        = _read_fixed(p.t, UInt16, true)
 
 read(p::TBinaryProtocol, ::Type{TI32})          = reinterpret(TI32, read(p, UInt32))
-read(p::TBinaryProtocol, ::Type{UInt32})        = _read_fixed(p.t, UInt32(0), 4, true)
+read(p::TBinaryProtocol, ::Type{UInt32})        = _read_fixed(p.t, UInt32, true)
 
 read(p::TBinaryProtocol, ::Type{TI64})          = reinterpret(TI64, read(p, UInt64))
-read(p::TBinaryProtocol, ::Type{UInt64})        = _read_fixed(p.t, UInt64(0), 8, true)
+read(p::TBinaryProtocol, ::Type{UInt64})        = _read_fixed(p.t, UInt64, true)
 
-read(p::TBinaryProtocol, ::Type{TDOUBLE})       = reinterpret(TDOUBLE, _read_fixed(p.t, UInt64(0), 8, true))
+read(p::TBinaryProtocol, ::Type{TDOUBLE})       = reinterpret(TDOUBLE, _read_fixed(p.t, UInt64, true))
 read!(p::TBinaryProtocol, a::Vector{UInt8})     = read!(p.t, a)
-read(p::TBinaryProtocol, ::Type{TUTF8})         = convert(TUTF8, String(read(p, Vector{UInt8})))
-read(p::TBinaryProtocol, ::Type{Vector{UInt8}}) = read!(p, Vector{UInt8}(undef, _read_fixed(p.t, UInt32(0), 4, true)))
+read(p::TBinaryProtocol, ::Type{TUTF8})         = String(read!(p, Base.StringVector(_read_fixed(p.t, UInt32, true))))
+read(p::TBinaryProtocol, ::Type{Vector{UInt8}}) = read!(p, Vector{UInt8}(undef, _read_fixed(p.t, UInt32, true)))
+read(p::TBinaryProtocol, ::Type{TBinaryView})   = readview(p.t, _read_fixed(p.t, UInt32, true))
+
+# fixed width values and strings are skipped over on the transport, without decoding them
+for _typ in (TBOOL, TBYTE, TI16, TI32, TI64, TDOUBLE)
+    @eval skip(p::TBinaryProtocol, ::Type{$(_typ)}) = skip(p.t, $(sizeof(_typ)))
+end
+skip_binary(p::TBinaryProtocol) = skip(p.t, _read_fixed(p.t, UInt32, true))
+fixed_width(::Type{TBinaryProtocol}, ttype::Integer) = (ttype == TType.BOOL || ttype == TType.BYTE) ? 1 :
+                                                       (ttype == TType.I16) ? 2 :
+                                                       (ttype == TType.I32) ? 4 :
+                                                       (ttype == TType.I64 || ttype == TType.DOUBLE) ? 8 : 0
+
+# serialized sizes
+field_header_size(::Type{TBinaryProtocol}, fid::Integer, last_fid::Integer) = 3
+bool_field_size(::Type{TBinaryProtocol}) = 1
+map_header_size(::Type{TBinaryProtocol}, size::Integer) = 6
+collection_header_size(::Type{TBinaryProtocol}, size::Integer) = 5
+serialized_size(::Type{TBinaryProtocol}, val::Union{TBOOL,TBYTE,TI16,TI32,TI64,TDOUBLE}) = sizeof(val)
+serialized_size(::Type{TBinaryProtocol}, val::TUTF8) = 4 + sizeof(val)
+serialized_size(::Type{TBinaryProtocol}, val::Vector{UInt8}) = 4 + length(val)
+serialized_size(::Type{TBinaryProtocol}, val::TBinaryView) = 4 + length(val)
+message_begin_size(p::TBinaryProtocol, name::AbstractString, seqid::Integer) = (p.strict_write ? 8 : 5) + serialized_size(TBinaryProtocol, name)
+reserve!(p::TBinaryProtocol, val) = wants_reserve(p.t) ? reserve!(p.t, serialized_size(p, val)) : nothing
+reserve!(p::TBinaryProtocol, name::AbstractString, seqid::Integer, val) = wants_reserve(p.t) ? reserve!(p.t, message_begin_size(p, name, seqid) + serialized_size(p, val)) : nothing
+
+# lists of fixed width primitives are copied in bulk
+const TBulkValue = Union{TI16, TI32, TI64, TDOUBLE}
+read_list_values!(p::TBinaryProtocol, val::Vector{T}, ::Type{T}, size::Integer) where {T <: TBulkValue} = _read_fixed_vector!(p.t, val, size, true)
+write_list_values(p::TBinaryProtocol, val::Vector{T}) where {T <: TBulkValue} = (_write_fixed_vector(p.t, val, true); nothing)
 
 # ==========================================
 # Compact Protocol
@@ -482,14 +511,41 @@ end
 
 readSize(p::TCompactProtocol) = readVarint(p, Int32)
 
-read(p::TCompactProtocol, t::Type{TBYTE})       = _read_fixed(p.t, UInt8(0), 1, true)
+read(p::TCompactProtocol, t::Type{TBYTE})       = _read_fixed(p.t, UInt8, true)
 read(p::TCompactProtocol, t::Type{TI16})        = _read_zigzag(p.t, t)
 read(p::TCompactProtocol, t::Type{TI32})        = _read_zigzag(p.t, t)
 read(p::TCompactProtocol, t::Type{TI64})        = _read_zigzag(p.t, t)
-read(p::TCompactProtocol, t::Type{TDOUBLE})     = reinterpret(TDOUBLE, _read_fixed(p.t, UInt64(0), 8, false))
+read(p::TCompactProtocol, t::Type{TDOUBLE})     = reinterpret(TDOUBLE, _read_fixed(p.t, UInt64, false))
 read!(p::TCompactProtocol, a::Vector{UInt8})    = read!(p.t, a)
-read(p::TCompactProtocol, ::Type{TUTF8})        = convert(TUTF8, String(read(p, Vector{UInt8})))
+read(p::TCompactProtocol, ::Type{TUTF8})        = String(read!(p, Base.StringVector(readSize(p))))
 read(p::TCompactProtocol, ::Type{Vector{UInt8}}) = read!(p, Vector{UInt8}(undef, readSize(p)))
+read(p::TCompactProtocol, ::Type{TBinaryView})  = readview(p.t, readSize(p))
+
+# integers are variable length and must be read to be skipped, doubles and strings are skipped over on the transport
+skip(p::TCompactProtocol, ::Type{TDOUBLE})      = skip(p.t, 8)
+skip_binary(p::TCompactProtocol)                = skip(p.t, readSize(p))
+fixed_width(::Type{TCompactProtocol}, ttype::Integer) = (ttype == TType.BOOL || ttype == TType.BYTE) ? 1 : (ttype == TType.DOUBLE) ? 8 : 0
+
+# serialized sizes
+field_header_size(::Type{TCompactProtocol}, fid::Integer, last_fid::Integer) = (0 < (fid - last_fid) <= 15) ? 1 : (1 + _zigzag_size(Int16(fid)))
+bool_field_size(::Type{TCompactProtocol}) = 0       # the value is in the field header
+map_header_size(::Type{TCompactProtocol}, size::Integer) = (size == 0) ? 1 : (_uleb_size(UInt32(size)) + 1)
+collection_header_size(::Type{TCompactProtocol}, size::Integer) = (size <= 14) ? 1 : (1 + _uleb_size(UInt32(size)))
+serialized_size(::Type{TCompactProtocol}, val::Union{TBOOL,TBYTE}) = 1
+serialized_size(::Type{TCompactProtocol}, val::Union{TI16,TI32,TI64}) = _zigzag_size(val)
+serialized_size(::Type{TCompactProtocol}, val::TDOUBLE) = 8
+serialized_size(::Type{TCompactProtocol}, val::TUTF8) = _uleb_size(UInt32(sizeof(val))) + sizeof(val)
+serialized_size(::Type{TCompactProtocol}, val::Vector{UInt8}) = _uleb_size(UInt32(length(val))) + length(val)
+serialized_size(::Type{TCompactProtocol}, val::TBinaryView) = _uleb_size(UInt32(length(val))) + length(val)
+message_begin_size(p::TCompactProtocol, name::AbstractString, seqid::Integer) = 2 + _uleb_size(unsigned(Int32(seqid))) + serialized_size(TCompactProtocol, name)
+reserve!(p::TCompactProtocol, val) = wants_reserve(p.t) ? reserve!(p.t, serialized_size(p, val)) : nothing
+reserve!(p::TCompactProtocol, name::AbstractString, seqid::Integer, val) = wants_reserve(p.t) ? reserve!(p.t, message_begin_size(p, name, seqid) + serialized_size(p, val)) : nothing
+
+# lists of integers are zigzag decoded in batches, doubles are copied in bulk
+read_list_values!(p::TCompactProtocol, val::Vector{T}, ::Type{T}, size::Integer) where {T <: Union{TI16, TI32, TI64}} = _read_zigzag_vector!(p.t, val, size)
+read_list_values!(p::TCompactProtocol, val::Vector{TDOUBLE}, ::Type{TDOUBLE}, size::Integer) = _read_fixed_vector!(p.t, val, size, false)
+write_list_values(p::TCompactProtocol, val::Vector{T}) where {T <: Union{TI16, TI32, TI64}} = (_write_zigzag_vector(p.t, val); nothing)
+write_list_values(p::TCompactProtocol, val::Vector{TDOUBLE}) = (_write_fixed_vector(p.t, val, false); nothing)
 
 # ==========================================
 # Header Protocol Begin
@@ -551,6 +607,17 @@ for _typ in _plain_types
     end
 end
 
+write(p::THeaderProtocol, val::Vector{UInt8}, framed::Bool) = write(p.proto, val, framed)
+read(p::THeaderProtocol, val::Type{TBinaryView}) = read(p.proto, val)
+skip_binary(p::THeaderProtocol) = skip_binary(p.proto)
+fixed_width(p::THeaderProtocol, ttype::Integer) = fixed_width(p.proto, ttype)
+serialized_size(p::THeaderProtocol, val) = serialized_size(p.proto, val)
+message_begin_size(p::THeaderProtocol, name::AbstractString, seqid::Integer) = message_begin_size(p.proto, name, seqid)
+reserve!(p::THeaderProtocol, val) = reserve!(p.proto, val)
+reserve!(p::THeaderProtocol, name::AbstractString, seqid::Integer, val) = reserve!(p.proto, name, seqid, val)
+read_list_values!(p::THeaderProtocol, val, jetype, size::Integer) = read_list_values!(p.proto, val, jetype, size)
+write_list_values(p::THeaderProtocol, val) = write_list_values(p.proto, val)
+
 # Allow protocol to be changed
 function reset_protocol(p::THeaderProtocol)
     proto_id(p) === p.t.proto_id && return
@@ -0,0 +1,311 @@
+##
+# Record files.
+#
+# An append only container of serialized messages, with random access to records by their index.
+#
+# File layout:
+#   header  : magic "TREC", version (UInt8), compression (UInt8), sync marker (16 bytes)
+#   blocks  : sync marker, record count (UInt32), raw size (UInt32), stored size (UInt32), stored bytes
+#   index   : (block offset (UInt64), index of first record in block (UInt64)) for each block
+#   trailer : block count (UInt64), record count (UInt64), index offset (UInt64), magic "TRIX"
+#
+# The raw bytes of a block are its records, each a varint length followed by the serialized message.
+# Blocks are compressed as a whole when compression is enabled. Integers are big endian.
+#
+# The index and trailer are written when the writer is closed. A file without them (e.g. one that
+# is still being written, or was not closed cleanly) is read by scanning for block sync markers.
+# Files are memory mapped for reading, and records of uncompressed files are decoded in place.
+
+const RECORD_MAGIC = UInt8['T', 'R', 'E', 'C']
+const RECORD_INDEX_MAGIC = UInt8['T', 'R', 'I', 'X']
+const RECORD_VERSION = 0x01
+const RECORD_SYNC_SZ = 16
+const RECORD_HEADER_SZ = length(RECORD_MAGIC) + 2 + RECORD_SYNC_SZ
+const RECORD_BLOCK_HEADER_SZ = RECORD_SYNC_SZ + 12
+const RECORD_TRAILER_SZ = 24 + length(RECORD_INDEX_MAGIC)
+
+const RECORD_COMPRESSION = Dict(:none => 0x00, :zlib => 0x01, :zstd => 0x02)
+
+function _record_codec(compression::UInt8, compress::Bool)
+    (compression == RECORD_COMPRESSION[:none]) && return nothing
+    codec = if compression == RECORD_COMPRESSION[:zlib]
+        compress ? ZlibCompressor() : ZlibDecompressor()
+    elseif compression == RECORD_COMPRESSION[:zstd]
+        compress ? ZstdCompressor() : ZstdDecompressor()
+    else
+        error("unknown record file compression $compression")
+    end
+    TranscodingStreams.initialize(codec)
+    codec
+end
+
+"""
+    TRecordWriter(io::IO; protocol=TCompactProtocol, compression=:none, blocksize=65536, index=true)
+    TRecordWriter(path::AbstractString; kwargs...)
+
+Write messages into a record file. Records are collected into blocks of about `blocksize` bytes,
+compressed as a whole if `compression` is `:zlib` or `:zstd`. An index of blocks is written at
+the end if `index` is set, which lets readers locate records without scanning the file.
+The writer must be closed to write the last block and the index.
+"""
+mutable struct TRecordWriter{P<:TProtocol}
+    io::IO
+    ownio::Bool
+    compression::UInt8
+    compressor::Union{Nothing,TranscodingStreams.Codec}
+    sync::Vector{UInt8}
+    blocksize::Int
+    index::Bool
+    block::IOBuffer             # raw bytes of the block being filled
+    nblock::Int                 # records in the block being filled
+    scratch::TMemoryTransport   # messages are serialized here before being added to the block
+    proto::P
+    blockoffsets::Vector{UInt64}
+    blockfirsts::Vector{UInt64}
+    nrecords::Int
+    pos::Int                    # bytes written to io
+
+    function TRecordWriter(io::IO; protocol::Type{P}=TCompactProtocol, compression::Symbol=:none, blocksize::Integer=65536, index::Bool=true, ownio::Bool=false) where {P<:TProtocol}
+        haskey(RECORD_COMPRESSION, compression) || throw(ArgumentError("unsupported compression $compression"))
+        ctype = RECORD_COMPRESSION[compression]
+        scratch = TMemoryTransport()
+        w = new{P}(io, ownio, ctype, _record_codec(ctype, true), rand(UInt8, RECORD_SYNC_SZ), blocksize, index, PipeBuffer(), 0, scratch, P(scratch), UInt64[], UInt64[], 0, 0)
+        w.pos += write(io, RECORD_MAGIC)
+        w.pos += write(io, RECORD_VERSION)
+        w.pos += write(io, ctype)
+        w.pos += write(io, w.sync)
+        w
+    end
+end
+TRecordWriter(path::AbstractString; kwargs...) = TRecordWriter(open(path, "w"); ownio=true, kwargs...)
+
+Base.length(w::TRecordWriter) = w.nrecords
+
+"""
+    write(w::TRecordWriter, msg)
+
+Serialize `msg` with the writer's protocol and append it as a record.
+"""
+function write(w::TRecordWriter, msg)
+    write(w.proto, msg)
+    writerecord(w, take!(w.scratch.buff))
+end
+
+"""
+    writerecord(w::TRecordWriter, bytes::Vector{UInt8})
+
+Append already serialized bytes as a record.
+"""
+function writerecord(w::TRecordWriter, bytes::Vector{UInt8})
+    _write_uleb(w.block, length(bytes))
+    write(w.block, bytes)
+    w.nblock += 1
+    w.nrecords += 1
+    (bytesavailable(w.block) >= w.blocksize) && _write_block(w)
+    nothing
+end
+
+function _write_block(w::TRecordWriter)
+    (w.nblock == 0) && return
+    raw = take!(w.block)
+    stored = (w.compressor === nothing) ? raw : transcode(w.compressor, raw)
+    push!(w.blockoffsets, w.pos)
+    push!(w.blockfirsts, w.nrecords - w.nblock)
+    w.pos += write(w.io, w.sync)
+    w.pos += _write_fixed(w.io, UInt32(w.nblock), true)
+    w.pos += _write_fixed(w.io, UInt32(length(raw)), true)
+    w.pos += _write_fixed(w.io, UInt32(length(stored)), true)
+    w.pos += write(w.io, stored)
+    w.nblock = 0
+    nothing
+end
+
+"""
+    flush(w::TRecordWriter)
+
+Write out the records added so far as a block. Frequent flushes make smaller blocks.
+"""
+function flush(w::TRecordWriter)
+    _write_block(w)
+    flush(w.io)
+end
+
+function close(w::TRecordWriter)
+    _write_block(w)
+    if w.index
+        indexoffset = w.pos
+        for (offset, first) in zip(w.blockoffsets, w.blockfirsts)
+            _write_fixed(w.io, offset, true)
+            _write_fixed(w.io, first, true)
+        end
+        _write_fixed(w.io, UInt64(length(w.blockoffsets)), true)
+        _write_fixed(w.io, UInt64(w.nrecords), true)
+        _write_fixed(w.io, UInt64(indexoffset), true)
+        write(w.io, RECORD_INDEX_MAGIC)
+    end
+    (w.compressor === nothing) || TranscodingStreams.finalize(w.compressor)
+    w.compressor = nothing
+    w.ownio ? close(w.io) : flush(w.io)
+    nothing
+end
+
+"""
+    TRecordReader(path::AbstractString; protocol=TCompactProtocol)
+
+Read a record file written by `TRecordWriter`. The file is memory mapped. Records are accessed by
+index, with `read(r, T, idx)` to decode a message of type `T`, or `r[idx]` to get its serialized
+bytes as a `TBinaryView`. Decompressed blocks are cached, so reading records in sequence
+decompresses each block only once. Closing the reader drops its reference to the mapped file
+contents, and reads after that throw.
+"""
+mutable struct TRecordReader{P<:TProtocol}
+    data::Vector{UInt8}
+    protocol::Type{P}
+    decompressor::Union{Nothing,TranscodingStreams.Codec}
+    sync::Vector{UInt8}
+    blockoffsets::Vector{Int}
+    blockfirsts::Vector{Int}
+    nrecords::Int
+    cachedblock::Int            # block whose records are located by cachedstarts and cachedlens
+    cacheddata::Vector{UInt8}   # bytes the cached block's records are in
+    cachedstarts::Vector{Int}   # start of each record in cacheddata
+    cachedlens::Vector{Int}     # length of each record
+
+    function TRecordReader(path::AbstractString; protocol::Type{P}=TCompactProtocol) where {P<:TProtocol}
+        data = open(path) do io
+            Mmap.mmap(io, Vector{UInt8}, filesize(io))
+        end
+        ((length(data) >= RECORD_HEADER_SZ) && (data[1:length(RECORD_MAGIC)] == RECORD_MAGIC)) || error("$path is not a record file")
+        (data[5] == RECORD_VERSION) || error("unsupported record file version $(data[5])")
+        sync = data[7:(6+RECORD_SYNC_SZ)]
+        r = new{P}(data, protocol, _record_codec(data[6], false), sync, Int[], Int[], 0, 0, data, Int[], Int[])
+        _read_index!(r) || _scan_blocks!(r)
+        r
+    end
+end
+
+Base.length(r::TRecordReader) = r.nrecords
+
+# the file contents are released on close, an open reader always has at least the file header
+isopen(r::TRecordReader) = !isempty(r.data)
+
+function close(r::TRecordReader)
+    (r.decompressor === nothing) || TranscodingStreams.finalize(r.decompressor)
+    r.decompressor = nothing
+    r.data = UInt8[]
+    r.cacheddata = r.data
+    r.cachedblock = 0
+    nothing
+end
+
+function _fixed_at(data::Vector{UInt8}, ::Type{T}, pos::Int) where {T<:Unsigned}
+    x = zero(T)
+    for idx in pos:(pos+sizeof(T)-1)
+        x = (x << 8) | data[idx]
+    end
+    x
+end
+
+# read the block index from the trailer, returns false if the file does not have a valid index
+function _read_index!(r::TRecordReader)
+    data = r.data
+    len = length(data)
+    (len >= (RECORD_HEADER_SZ + RECORD_TRAILER_SZ)) || return false
+    (data[(len-length(RECORD_INDEX_MAGIC)+1):len] == RECORD_INDEX_MAGIC) || return false
+    pos = len - RECORD_TRAILER_SZ + 1
+    nblocks = Int(_fixed_at(data, UInt64, pos))
+    nrecords = Int(_fixed_at(data, UInt64, pos+8))
+    indexoffset = Int(_fixed_at(data, UInt64, pos+16))
+    ((indexoffset + 16*nblocks) == (pos - 1)) || return false
+
+    resize!(r.blockoffsets, nblocks)
+    resize!(r.blockfirsts, nblocks)
+    for idx in 1:nblocks
+        r.blockoffsets[idx] = Int(_fixed_at(data, UInt64, indexoffset + 16*(idx-1) + 1))
+        r.blockfirsts[idx] = Int(_fixed_at(data, UInt64, indexoffset + 16*(idx-1) + 9))
+    end
+    r.nrecords = nrecords
+    true
+end
+
+_issync(r::TRecordReader, pos::Int) = ((pos + RECORD_SYNC_SZ - 1) <= length(r.data)) && all(idx->(r.data[pos+idx-1] == r.sync[idx]), 1:RECORD_SYNC_SZ)
+
+# locate blocks by their sync markers, skipping over incomplete or damaged blocks
+function _scan_blocks!(r::TRecordReader)
+    data = r.data
+    len = length(data)
+    pos = RECORD_HEADER_SZ + 1
+    nrecords = 0
+    while (pos + RECORD_BLOCK_HEADER_SZ - 1) <= len
+        if _issync(r, pos)
+            stored = Int(_fixed_at(data, UInt32, pos + RECORD_SYNC_SZ + 8))
+            blockend = pos + RECORD_BLOCK_HEADER_SZ + stored - 1
+            if blockend <= len
+                push!(r.blockoffsets, pos - 1)
+                push!(r.blockfirsts, nrecords)
+                nrecords += Int(_fixed_at(data, UInt32, pos + RECORD_SYNC_SZ))
+                pos = blockend + 1
+                continue
+            end
+        end
+        pos += 1
+    end
+    r.nrecords = nrecords
+    nothing
+end
+
+# locate the records of block `blk`, decompressing it if required
+function _load_block!(r::TRecordReader, blk::Int)
+    (r.cachedblock == blk) && return
+    pos = r.blockoffsets[blk] + 1
+    data = r.data
+    nrec = Int(_fixed_at(data, UInt32, pos + RECORD_SYNC_SZ))
+    stored = Int(_fixed_at(data, UInt32, pos + RECORD_SYNC_SZ + 8))
+    first = pos + RECORD_BLOCK_HEADER_SZ
+    if r.decompressor !== nothing
+        data = transcode(r.decompressor, data[first:(first+stored-1)])
+        first = 1
+        stored = length(data)
+    end
+
+    buf = seek(IOBuffer(data), first - 1)
+    starts = resize!(r.cachedstarts, nrec)
+    lens = resize!(r.cachedlens, nrec)
+    for ridx in 1:nrec
+        lens[ridx] = _read_uleb(buf, Int)
+        starts[ridx] = position(buf) + 1
+        skip(buf, lens[ridx])
+    end
+    (position(buf) <= (first + stored - 1)) || error("records overrun block $blk")
+    r.cacheddata = data
+    r.cachedblock = blk
+    nothing
+end
+
+# returns the bytes holding record `idx`, and its start and length in them
+function _locate(r::TRecordReader, idx::Integer)
+    isopen(r) || error("record reader is closed")
+    (1 <= idx <= r.nrecords) || throw(BoundsError(r, idx))
+    blk = searchsortedlast(r.blockfirsts, idx - 1)
+    _load_block!(r, blk)
+    ridx = idx - r.blockfirsts[blk]
+    (r.cacheddata, r.cachedstarts[ridx], r.cachedlens[ridx])
+end
+
+Base.getindex(r::TRecordReader, idx::Integer) = ((data, start, len) = _locate(r, idx); TBinaryView(data, start - 1, len))
+
+"""
+    read(r::TRecordReader, T, idx::Integer)
+
+Decode record `idx` as a message of type `T`, directly from the file contents for uncompressed files.
+"""
+function read(r::TRecordReader, ::Type{T}, idx::Integer) where T
+    (data, start, len) = _locate(r, idx)
+    buf = seek(IOBuffer(data), start - 1)
+    msg = read(r.protocol(TMemoryTransport(buf)), T)
+    (position(buf) == (start + len - 1)) || error("record $idx does not hold one $T message")
+    msg
+end
+
+Base.iterate(r::TRecordReader, idx::Int=1) = (idx > r.nrecords) ? nothing : (r[idx], idx+1)
+Base.eltype(::Type{<:TRecordReader}) = TBinaryView
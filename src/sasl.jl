@@ -68,7 +68,7 @@ end
 function sasl_read(io::IO)
     status = read(io, UInt8)
     @debug("read_sasl", status)
-    len = _read_fixed(io, UInt32(0), 4, true)
+    len = _read_fixed(io, UInt32, true)
     @debug("read_sasl", len)
     data = read!(io, Vector{UInt8}(undef, len))
     @debug("read_sasl", data)
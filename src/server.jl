@@ -6,17 +6,48 @@ mutable struct TServerBase
     in_p::Function
     out_t::Function
     out_p::Function
+    pipelined::Bool
+    TServerBase(srvr_t::TServerTransport, processor::TProcessor, in_t::Function, in_p::Function, out_t::Function, out_p::Function) = new(srvr_t, processor, in_t, in_p, out_t, out_p, false)
 end
 
-function serve_accepted(client::TTransport, s::TServerBase)
+"""
+    pipelined(srvr::TServer, flag::Bool=true)
+
+Process requests on a connection out of order. The next request on a connection is read as soon as the
+previous one is decoded, handlers run concurrently in tasks spawned across threads, and replies are sent as
+handlers complete. Handlers must be safe to run on any thread. Useful with pipelining clients (e.g. generated async clients), where one slow call would otherwise
+hold up all calls behind it. The processor must implement `process(p, inp, outp, outlock::ReentrantLock)`.
+"""
+pipelined(srvr::TServer, flag::Bool=true) = (srvr.base.pipelined = flag; nothing)
+
+# Runs `f`, which processes the next request on a connection, in the task serving the connection.
+_inline(f::Function, itrans::TTransport) = f()
+
+function serve_accepted(client::TTransport, s::TServerBase, dispatch::Function=_inline)
+    m = metrics(s.processor)
+    if m !== nothing
+        client = TMeteredTransport(client)
+        _connection!(m, 1)
+    end
     itrans = s.in_t(client)
     otrans = s.out_t(client)
     iprot = s.in_p(itrans)
     oprot = s.out_p(otrans)
+    outlock = ReentrantLock()
+    # replies held back by the reply transport must be sent before waiting for more requests
+    _onwait!(itrans, ()->_send_held(otrans, outlock))
 
     try
-        while true
-            process(s.processor, iprot, oprot)
+        if s.pipelined
+            serve_pipelined(s.processor, iprot, oprot, outlock) do f
+                dispatch(f, itrans)
+            end
+        else
+            while true
+                dispatch(itrans) do
+                    process(s.processor, iprot, oprot)
+                end
+            end
         end
     catch ex
         if !isa(ex, EOFError)
@@ -26,6 +57,21 @@ function serve_accepted(client::TTransport, s::TServerBase)
     end
     close(itrans)
     close(otrans)
+    (m === nothing) || _connection!(m, -1)
+end
+
+function serve_pipelined(run::Function, processor::TProcessor, iprot::TProtocol, oprot::TProtocol, outlock::ReentrantLock)
+    inflight = Task[]
+    try
+        while true
+            t = run(()->process(processor, iprot, oprot, outlock))
+            (t === nothing) || push!(inflight, t)
+            filter!(!istaskdone, inflight)
+        end
+    finally
+        # let requests already read complete their replies before the connection is closed
+        foreach(wait, inflight)
+    end
 end
 
 close(srvr::TServer) = close(srvr.base.srvr_t)
@@ -77,3 +123,109 @@ function serve(ss::TAsyncServer)
         @async serve_accepted(client, s)
     end
 end
+
+
+##
+# Thread Pool Server
+# A fixed number of worker tasks, spawned across threads, process requests taken from a bounded queue.
+# Each connection is watched by a task of its own, which waits till the next request arrives and then
+# queues its processing, so idle connections do not hold up a worker. Requests on a connection are still
+# processed one at a time (in pipelined mode, a worker reads the request and starts its handler).
+# Accepting new connections pauses while the queue is full, till a worker takes a job from it.
+mutable struct TThreadPoolServer <: TServer
+    base::TServerBase
+    nworkers::Int
+    queuesize::Int
+    function TThreadPoolServer(srvr_t::TServerTransport, processor::TProcessor, in_t::Function, in_p::Function, out_t::Function, out_p::Function;
+            nworkers::Int=Threads.nthreads(), queuesize::Int=nworkers)
+        new(TServerBase(srvr_t, processor, in_t, in_p, out_t, out_p), nworkers, queuesize)
+    end
+end
+
+const ThreadPoolJob = Tuple{Function,Channel{Any}}
+
+# Jobs waiting for a worker. `nqueued` also counts jobs that connection tasks are waiting to queue.
+mutable struct ThreadPoolQueue
+    jobs::Channel{ThreadPoolJob}
+    size::Int
+    cond::Threads.Condition     # guards nqueued, notified when a worker takes a job
+    nqueued::Int
+    ThreadPoolQueue(size::Int) = new(Channel{ThreadPoolJob}(size), size, Threads.Condition(), 0)
+end
+
+function serve(ss::TThreadPoolServer)
+    s = ss.base
+    listen(s.srvr_t)
+
+    q = ThreadPoolQueue(ss.queuesize)
+    for _ in 1:ss.nworkers
+        Threads.@spawn _serve_jobs(q)
+    end
+    dispatch = (f, itrans) -> _dispatch(q, f, itrans)
+    try
+        while true
+            _wait_capacity(q)
+            client = accept(s.srvr_t)
+            @async serve_accepted(client, s, dispatch)
+        end
+    finally
+        close(q.jobs)
+    end
+end
+
+function _queued!(q::ThreadPoolQueue, n::Int)
+    lock(q.cond)
+    try
+        q.nqueued += n
+        (n < 0) && notify(q.cond)
+    finally
+        unlock(q.cond)
+    end
+    nothing
+end
+
+# wait till the queue has room for more jobs
+function _wait_capacity(q::ThreadPoolQueue)
+    lock(q.cond)
+    try
+        while q.nqueued >= q.size
+            wait(q.cond)
+        end
+    finally
+        unlock(q.cond)
+    end
+    nothing
+end
+
+function _serve_jobs(q::ThreadPoolQueue)
+    for (f, done) in q.jobs
+        _queued!(q, -1)
+        res = try
+            f()
+        catch ex
+            CapturedException(ex, catch_backtrace())
+        end
+        put!(done, res)
+    end
+end
+
+function _dispatch(q::ThreadPoolQueue, f::Function, itrans::TTransport)
+    _wait_readable(itrans)
+    done = Channel{Any}(1)
+    _queued!(q, 1)
+    put!(q.jobs, (f, done))
+    res = take!(done)
+    isa(res, CapturedException) && throw(res.ex)
+    res
+end
+
+# wait till the next request can be read on a connection, without reading any of it
+function _wait_readable(itrans::TTransport)
+    buf = readbuffer(itrans)
+    ((buf !== nothing) && (bytesavailable(buf) > 0)) && return
+    io = rawio(itrans)
+    (bytesavailable(io) > 0) && return
+    _beforewait(itrans)
+    eof(io) && throw(EOFError())
+    nothing
+end
@@ -15,6 +15,35 @@ struct TTransportException <: Exception
     TTransportException(typ=TransportExceptionTypes.UNKNOWN, message::AbstractString="") = new(typ, message)
 end
 
+"""
+    readview(t::TTransport, sz::Integer)
+
+Read `sz` bytes as a `TBinaryView`. Framed and header transports return a view into the
+frame they read without copying, others read into a new array.
+"""
+readview(t::TTransport, sz::Integer) = TBinaryView(read!(t, Vector{UInt8}(undef, sz)))
+
+# view the next `sz` bytes of `buf`, a PipeBuffer over the array `data` owned by the transport
+function _readview(data::Vector{UInt8}, buf::IOBuffer, sz::Integer)
+    v = TBinaryView(data, position(buf), sz)
+    skip(buf, sz)
+    v
+end
+
+"""
+    skip(t::TTransport, sz::Integer)
+
+Skip over the next `sz` bytes. Buffered transports move past bytes in their read
+buffer without copying them, others read and discard the bytes.
+"""
+skip(t::TTransport, sz::Integer) = (read(t, sz); nothing)
+
+# skip up to `sz` bytes available in `buf`, returns the number of bytes skipped
+function _skip!(buf::IOBuffer, sz::Integer)
+    n = min(bytesavailable(buf), sz)
+    skip(buf, n)
+    n
+end
 
 # TODO: Thrift SASL server transport
 # Thrift SASL client transport
@@ -39,6 +68,7 @@ flush(t::TSASLClientTransport)  = flush(t.tp)
 read!(t::TSASLClientTransport, buff::Vector{UInt8}) = read!(t.tp, buff)
 read(t::TSASLClientTransport, type::Type{<:Unsigned}) = read(t.tp, type)
 read(t::TSASLClientTransport, sz::Integer) = read(t.tp, sz)
+skip(t::TSASLClientTransport, sz::Integer) = skip(t.tp, sz)
 function write(t::TSASLClientTransport, buff::Vector{UInt8})
     @debug("TSASLClientTransport buffering bytes", len=length(buff))
     write(t.tp, buff)
@@ -47,6 +77,9 @@ function write(t::TSASLClientTransport, b::UInt8)
     @debug("TSASLClientTransport buffering 1 byte")
     write(t.tp, b)
 end
+write(t::TSASLClientTransport, x::TFixedWidth) = write(t.tp, x)
+readbuffer(t::TSASLClientTransport) = readbuffer(t.tp)
+writebuffer(t::TSASLClientTransport) = writebuffer(t.tp)
 
 function open(t::TSASLClientTransport)
     open(t.tp)
@@ -55,23 +88,52 @@ end
 
 
 # Thrift Framed Transport
+#
+# The read frame and write buffer are reused across frames. The write buffer starts with space for the
+# frame size, which is filled in at flush, so the frame goes out in a single write. Frames are read
+# directly into the array of the last frame, unless it is still referred to by views handed out by `readview`.
+const FRAME_HEADER_SZ = 4
+
 mutable struct TFramedTransport <: TTransport
     tp::TTransport
+    rframe::Vector{UInt8}   # array the read buffer is over
     rbuff::IOBuffer
     wbuff::IOBuffer
-    TFramedTransport(tp::TTransport) = new(tp, PipeBuffer(), PipeBuffer())
+    rviews::Bool            # whether views into rframe have been handed out
+    wcapacity::Int          # bytes the array under wbuff can hold without growing
+    function TFramedTransport(tp::TTransport)
+        rframe = UInt8[]
+        new(tp, rframe, PipeBuffer(rframe), _wframe(), false, 0)
+    end
 end
 rawio(t::TFramedTransport)  = rawio(t.tp)
 open(t::TFramedTransport)   = open(t.tp)
 close(t::TFramedTransport)  = close(t.tp)
 isopen(t::TFramedTransport) = isopen(t.tp)
 
-readframesz(t::TFramedTransport) = _read_fixed(t.tp, UInt32(0), 4, true)
+# a write buffer over `data`, with room for the frame size
+function _wframe(data::Vector{UInt8}=UInt8[])
+    buf = IOBuffer(data; read=true, write=true, truncate=true)
+    write(buf, UInt32(0))
+    buf
+end
+
+readframesz(t::TFramedTransport) = _read_fixed(t.tp, UInt32, true)
 function readframe(t::TFramedTransport)
     @debug("TFramedTransport reading frame")
     sz = readframesz(t)
     @debug("TFramedTransport reading frame", sz)
-    write(t.rbuff, read!(t.tp, Vector{UInt8}(undef,sz)))
+    navlb = bytesavailable(t.rbuff)
+    if (navlb == 0) && !t.rviews
+        # nothing refers to the last frame any more, read the frame into its array
+        read!(t.tp, resize!(t.rframe, sz))
+    else
+        # a new array leaves views into earlier frames valid
+        frame = read!(t.tp, Vector{UInt8}(undef,sz))
+        t.rframe = (navlb > 0) ? append!(read(t.rbuff, navlb), frame) : frame
+        t.rviews = false
+    end
+    t.rbuff = PipeBuffer(t.rframe)
     @debug("TFramedTransport read frame", sz)
     nothing
 end
@@ -96,7 +158,7 @@ function read!(t::TFramedTransport, buff::Vector{UInt8})
 end
 function read(t::TFramedTransport, type::Type{<:Unsigned})
     navlb = bytesavailable(t.rbuff)
-    if navlb == 0
+    if navlb < sizeof(type)
         readframe(t)
     end
     return read(t.rbuff, type)
@@ -109,6 +171,15 @@ function read(t::TFramedTransport, sz::Integer)
     return read(t.rbuff, sz)
 end
 
+function skip(t::TFramedTransport, sz::Integer)
+    nremain = sz - _skip!(t.rbuff, sz)
+    while nremain > 0
+        readframe(t)
+        nremain -= _skip!(t.rbuff, nremain)
+    end
+    nothing
+end
+
 function write(t::TFramedTransport, buff::Vector{UInt8})
     @debug("TFramedTransport buffering bytes", len=length(buff))
     write(t.wbuff, buff)
@@ -117,18 +188,158 @@ function write(t::TFramedTransport, b::UInt8)
     @debug("TFramedTransport buffering 1 byte")
     write(t.wbuff, b)
 end
+write(t::TFramedTransport, x::TFixedWidth) = write(t.wbuff, x)
+readbuffer(t::TFramedTransport) = t.rbuff
+function readview(t::TFramedTransport, sz::Integer)
+    (bytesavailable(t.rbuff) == 0) && readframe(t)
+    if bytesavailable(t.rbuff) >= sz
+        t.rviews = true
+        _readview(t.rframe, t.rbuff, sz)
+    else
+        TBinaryView(read!(t, Vector{UInt8}(undef, sz)))
+    end
+end
+writebuffer(t::TFramedTransport) = t.wbuff
+wants_reserve(t::TFramedTransport) = (position(t.wbuff) == FRAME_HEADER_SZ)
+function reserve!(t::TFramedTransport, nbytes::Integer)
+    needed = FRAME_HEADER_SZ + nbytes
+    if (position(t.wbuff) == FRAME_HEADER_SZ) && (needed > t.wcapacity)
+        # nothing written into the frame yet, start it in an array large enough
+        t.wbuff = _wframe(sizehint!(UInt8[], needed))
+        t.wcapacity = needed
+    end
+    nothing
+end
 function flush(t::TFramedTransport)
-    szbuff = IOBuffer()
-    navlb = bytesavailable(t.wbuff)
+    buf = t.wbuff
+    navlb = position(buf) - FRAME_HEADER_SZ
     @debug("sending data", navlb)
-    _write_fixed(szbuff, UInt32(navlb), true)
-    nbyt = write(t.tp, take!(szbuff))
-    nbyt += write(t.tp, take!(t.wbuff))
+    seekstart(buf)
+    write(buf, hton(UInt32(navlb)))
+    frame = take!(buf)
+    nbyt = write(t.tp, frame)
+    t.wbuff = _wframe(frame)
+    t.wcapacity = max(t.wcapacity, length(frame))
     @debug("wrote frame", nbyt)
     flush(t.tp)
 end
 
 
+# Thrift Buffered Transport
+#
+# Reads are served from a read buffer that is filled with as many bytes as are readily available
+# (up to `rbuffsize`), and writes are collected in a write buffer that is sent when it grows beyond
+# `wbuffsize` or when flushed. With `coalesce` set (meant for servers), flushing is put off while
+# more requests are readable on the connection, so replies to pipelined requests are sent together.
+# Pending replies are always sent before waiting for more data to be read, including those held back
+# by a separate transport writing replies on the same connection (servers link the two with `_onwait!`).
+mutable struct TBufferedTransport <: TTransport
+    tp::TTransport
+    rbuff::IOBuffer
+    wbuff::IOBuffer
+    rscratch::Vector{UInt8}
+    rbuffsize::Int
+    wbuffsize::Int
+    coalesce::Bool
+    onwait::Union{Nothing,Function}
+    TBufferedTransport(tp::TTransport; rbuffsize::Integer=8192, wbuffsize::Integer=8192, coalesce::Bool=false) = new(tp, PipeBuffer(), PipeBuffer(), UInt8[], rbuffsize, wbuffsize, coalesce, nothing)
+end
+rawio(t::TBufferedTransport)  = rawio(t.tp)
+open(t::TBufferedTransport)   = open(t.tp)
+close(t::TBufferedTransport)  = close(t.tp)
+isopen(t::TBufferedTransport) = isopen(t.tp)
+
+# bytes that can be read from the underlying transport without waiting
+_readable(t::TBufferedTransport) = bytesavailable(rawio(t.tp))
+
+# about to wait for the peer, which may be waiting for replies held back
+function _beforewait(t::TBufferedTransport)
+    if t.coalesce && (bytesavailable(t.wbuff) > 0)
+        _send(t)
+        flush(t.tp)
+    end
+    (t.onwait === nothing) || t.onwait()
+    nothing
+end
+_beforewait(t::TTransport) = nothing
+
+# have `f` called before the transport waits for more data to read
+_onwait!(t::TBufferedTransport, f::Function) = (t.onwait = f; nothing)
+_onwait!(t::TTransport, f::Function) = nothing
+
+# send replies held back by a coalescing transport, holding `outlock` that guards writing replies
+function _send_held(t::TBufferedTransport, outlock::ReentrantLock)
+    t.coalesce || return
+    lock(outlock)
+    try
+        if bytesavailable(t.wbuff) > 0
+            _send(t)
+            flush(t.tp)
+        end
+    finally
+        unlock(outlock)
+    end
+    nothing
+end
+_send_held(t::TTransport, outlock::ReentrantLock) = nothing
+
+# fill the read buffer to have at least `nbytes` bytes
+function _fill!(t::TBufferedTransport, nbytes::Integer)
+    navlb = bytesavailable(t.rbuff)
+    (navlb >= nbytes) && return
+    nreadable = _readable(t)
+    (nreadable < (nbytes - navlb)) && _beforewait(t)
+    sz = max(nbytes - navlb, min(nreadable, t.rbuffsize - navlb))
+    read!(t.tp, resize!(t.rscratch, sz))
+    write(t.rbuff, t.rscratch)
+    nothing
+end
+
+function read!(t::TBufferedTransport, buff::Vector{UInt8})
+    if (bytesavailable(t.rbuff) == 0) && (length(buff) >= t.rbuffsize)
+        (_readable(t) < length(buff)) && _beforewait(t)
+        return read!(t.tp, buff)
+    end
+    _fill!(t, length(buff))
+    read!(t.rbuff, buff)
+end
+read(t::TBufferedTransport, type::Type{<:Unsigned}) = (_fill!(t, sizeof(type)); read(t.rbuff, type))
+read(t::TBufferedTransport, sz::Integer) = (_fill!(t, sz); read(t.rbuff, sz))
+function skip(t::TBufferedTransport, sz::Integer)
+    nremain = sz - _skip!(t.rbuff, sz)
+    if nremain > 0
+        (_readable(t) < nremain) && _beforewait(t)
+        skip(t.tp, nremain)
+    end
+    nothing
+end
+readbuffer(t::TBufferedTransport) = t.rbuff
+
+_send(t::TBufferedTransport) = (bytesavailable(t.wbuff) > 0) ? write(t.tp, take!(t.wbuff)) : 0
+function write(t::TBufferedTransport, buff::Vector{UInt8})
+    ((bytesavailable(t.wbuff) + length(buff)) > t.wbuffsize) && _send(t)
+    (length(buff) >= t.wbuffsize) ? write(t.tp, buff) : write(t.wbuff, buff)
+end
+function write(t::TBufferedTransport, b::UInt8)
+    nbyt = write(t.wbuff, b)
+    (bytesavailable(t.wbuff) >= t.wbuffsize) && _send(t)
+    nbyt
+end
+function write(t::TBufferedTransport, x::TFixedWidth)
+    nbyt = write(t.wbuff, x)
+    (bytesavailable(t.wbuff) >= t.wbuffsize) && _send(t)
+    nbyt
+end
+writebuffer(t::TBufferedTransport) = t.wbuff
+function flush(t::TBufferedTransport)
+    if t.coalesce && ((bytesavailable(t.rbuff) > 0) || (_readable(t) > 0)) && (bytesavailable(t.wbuff) < t.wbuffsize)
+        @debug("TBufferedTransport holding back flush, more requests are readable")
+        return
+    end
+    _send(t)
+    flush(t.tp)
+end
+
 # Thrift Socket Transport
 mutable struct TSocket <: TTransport
     host::AbstractString
@@ -222,6 +433,11 @@ function write(tsock::TSocketBase, b::UInt8)
     return write(tsock.io, b)
 end
 
+function write(tsock::TSocketBase, x::TFixedWidth)
+    @debug("TSocketBase.write", tsock, x)
+    return write(tsock.io, x)
+end
+
 flush(tsock::TSocketBase)   = flush(tsock.io)
 isopen(tsock::TSocketBase)  = (isdefined(tsock, :io) && isreadable(tsock.io) && iswritable(tsock.io))
 
@@ -231,6 +447,7 @@ mutable struct TMemoryTransport <: TTransport
 
     TMemoryTransport() = new(PipeBuffer())
     TMemoryTransport(buff::Array{UInt8}) = new(PipeBuffer(buff))
+    TMemoryTransport(buff::IOBuffer) = new(buff)
 end
 
 rawio(t::TMemoryTransport)  = t.buff
@@ -241,8 +458,12 @@ flush(t::TMemoryTransport)  = nothing
 read!(t::TMemoryTransport, buff::Vector{UInt8}) = read!(t.buff, buff)
 read(t::TMemoryTransport, type::Type{<:Unsigned}) = read(t.buff, type)
 read(t::TMemoryTransport, sz::Integer) = read(t.buff, sz)
+skip(t::TMemoryTransport, sz::Integer) = (bytesavailable(t.buff) >= sz) ? (_skip!(t.buff, sz); nothing) : throw(EOFError())
 write(t::TMemoryTransport, buff::Vector{UInt8}) = write(t.buff, buff)
 write(t::TMemoryTransport, b::UInt8) = write(t.buff, b)
+write(t::TMemoryTransport, x::TFixedWidth) = write(t.buff, x)
+readbuffer(t::TMemoryTransport) = t.buff
+writebuffer(t::TMemoryTransport) = t.buff
 
 # Thrift File IO Transport
 mutable struct TFileTransport <: TTransport
@@ -259,6 +480,9 @@ read(t::TFileTransport, type::Type{<:Unsigned}) = read(t.handle, type)
 read(t::TFileTransport, sz::Integer) = read(t.handle, sz)
 write(t::TFileTransport, buff::Vector{UInt8}) = write(t.handle, buff)
 write(t::TFileTransport, b::UInt8) = write(t.handle, b)
+write(t::TFileTransport, x::TFixedWidth) = write(t.handle, x)
+readbuffer(t::TFileTransport) = readbuffer(t.handle)
+writebuffer(t::TFileTransport) = writebuffer(t.handle)
 
 # ---------------------------------------------------------------------
 # THeader transport
@@ -325,6 +549,7 @@ module Magic
     const BIG_FRAME_MAGIC = 0x42494746  # BIGF
     const MAX_FRAME_SIZE = 0x3FFFFFFF
     const PACKED_HEADER_MAGIC = [0x0f, 0xff]
+    const MIN_TRANSFORM_SIZE = 256
 end
 
 module HeaderConstants
@@ -342,6 +567,7 @@ For examples, `THeaderTransport{TSocket}` or `THeaderTransport{TMemory}`.
 """
 mutable struct THeaderTransport{T <: TTransport} <: TTransport
     tp::T
+    rdata::Vector{UInt8}    # payload of the last frame read, which rbuf is over
     rbuf::IOBuffer
     wbuf::IOBuffer
     seqid::Int
@@ -358,9 +584,12 @@ mutable struct THeaderTransport{T <: TTransport} <: TTransport
     write_headers::HeadersType
     write_persistent_headers::HeadersType
     max_frame_size::UInt64
+    min_transform_size::Int                             # payloads smaller than this are sent without transforms
+    codecs::Dict{Tuple{TransformIDEnum,Bool},TranscodingStreams.Codec}     # (transform, compress) => codec, reused across frames
 
     THeaderTransport(transport::T) where {T <: TTransport} = new{T}(
         transport,
+        UInt8[],               # rdata
         PipeBuffer(),          # rbuf
         PipeBuffer(),          # wbuf
         0,                     # seqid
@@ -377,6 +606,8 @@ mutable struct THeaderTransport{T <: TTransport} <: TTransport
         HeadersType(),         # write_headers
         HeadersType(),         # write_persistent_headers
         Magic.MAX_FRAME_SIZE,  # max_frame_size
+        Magic.MIN_TRANSFORM_SIZE,  # min_transform_size
+        Dict{Tuple{TransformIDEnum,Bool},TranscodingStreams.Codec}(),  # codecs
     )
 end
 
@@ -394,7 +625,7 @@ end
 
 rawio(t::THeaderTransport)  = rawio(t.tp)
 open(t::THeaderTransport)   = open(t.tp)
-close(t::THeaderTransport)  = close(t.tp)
+close(t::THeaderTransport)  = (finalize_codecs!(t); close(t.tp))
 isopen(t::THeaderTransport) = isopen(t.tp)
 
 read!(t::THeaderTransport, buff::Vector{UInt8}) = read!(t.rbuf, buff)
@@ -408,6 +639,15 @@ function read(t::THeaderTransport, sz::Integer)
     return append!(data, take!(t.rbuf, remaining))
 end
 
+function skip(t::THeaderTransport, sz::Integer)
+    nremain = sz - _skip!(t.rbuf, sz)
+    while nremain > 0
+        read_frame!(t)
+        nremain -= _skip!(t.rbuf, nremain)
+    end
+    nothing
+end
+
 function read(t::THeaderTransport, DT::DataType)
     navlb = bytesavailable(t.rbuf)
     if navlb == 0
@@ -585,7 +825,8 @@ function read_payload!(t::THeaderTransport, buf::IOBuffer, end_header::Integer)
     payload_size = t.frame_size - end_header
     payload = read(buf, payload_size)
     @debug("read_header_format!", tohex(payload))
-    t.rbuf = PipeBuffer(untransform(t, payload))
+    t.rdata = untransform(t, payload)
+    t.rbuf = PipeBuffer(t.rdata)
     return nothing
 end
 
@@ -630,24 +871,63 @@ end
 
 write(t::THeaderTransport, buff::Vector{UInt8}) = write(t.wbuf, buff)
 write(t::THeaderTransport, b::UInt8) = write(t.wbuf, b)
+write(t::THeaderTransport, x::TFixedWidth) = write(t.wbuf, x)
+readbuffer(t::THeaderTransport) = t.rbuf
+readview(t::THeaderTransport, sz::Integer) = (bytesavailable(t.rbuf) >= sz) ? _readview(t.rdata, t.rbuf, sz) : TBinaryView(read(t, sz))
+writebuffer(t::THeaderTransport) = t.wbuf
 
 """
-    transform(t::THeaderTransport, data::Vector{UInt8})
+    codec!(t::THeaderTransport, trans_id::TransformIDEnum, compress::Bool)
 
-Transform `data` using the configured `write_transforms` from the transport.
+Return the codec for transform `trans_id` in the direction given by `compress`.
+Codecs are created and initialized on first use and reused for later frames.
 """
-function transform(t::THeaderTransport, data::Vector{UInt8})
-    if !isempty(t.write_transforms)
-        @debug("Transform method(s): " * join(t.write_transforms, ","))
-    end
-    for trans_id in t.write_transforms
-        if trans_id == TransformID.ZLIB
-            data = transform_data(ZlibCompressor, data)
+function codec!(t::THeaderTransport, trans_id::TransformIDEnum, compress::Bool)
+    get!(t.codecs, (trans_id, compress)) do
+        codec = if trans_id == TransformID.ZLIB
+            compress ? ZlibCompressor() : ZlibDecompressor()
         elseif trans_id == TransformID.ZSTD
-            data = transform_data(ZstdCompressor, data)
+            compress ? ZstdCompressor() : ZstdDecompressor()
         else
             throw_header_exception("Unsupported transformation: $trans_id")
         end
+        TranscodingStreams.initialize(codec)
+        codec
+    end
+end
+
+"""
+    finalize_codecs!(t::THeaderTransport)
+
+Release the codecs held by the transport.
+"""
+function finalize_codecs!(t::THeaderTransport)
+    for codec in values(t.codecs)
+        TranscodingStreams.finalize(codec)
+    end
+    empty!(t.codecs)
+    return nothing
+end
+
+"""
+    frame_transforms(t::THeaderTransport, payload_size::Integer)
+
+Return the transforms to apply to a payload of `payload_size` bytes. Payloads smaller than
+`min_transform_size` are not transformed, as that costs more than it saves.
+"""
+frame_transforms(t::THeaderTransport, payload_size::Integer) = (payload_size < t.min_transform_size) ? TransformIDEnum[] : t.write_transforms
+
+"""
+    transform(t::THeaderTransport, data::Vector{UInt8}, transforms=t.write_transforms)
+
+Transform `data` using `transforms`, the configured `write_transforms` from the transport by default.
+"""
+function transform(t::THeaderTransport, data::Vector{UInt8}, transforms::Vector{TransformIDEnum}=t.write_transforms)
+    if !isempty(transforms)
+        @debug("Transform method(s): " * join(transforms, ","))
+    end
+    for trans_id in transforms
+        data = transcode(codec!(t, trans_id, true), data)
     end
     return data
 end
@@ -662,13 +942,7 @@ function untransform(t::THeaderTransport, data::Vector{UInt8})
         @debug("Unransform method(s): " * join(t.read_transforms, ","))
     end
     for trans_id in t.read_transforms
-        if trans_id == TransformID.ZLIB
-            data = transform_data(ZlibDecompressor, data)
-        elseif trans_id == TransformID.ZSTD
-            data = transform_data(ZstdDecompressor, data)
-        else
-            throw_header_exception("Unsupported transformation: $trans_id")
-        end
+        data = transcode(codec!(t, trans_id, false), data)
     end
     return data
 end
@@ -679,12 +953,21 @@ end
 Make a new header message and flush it over the wire.
 """
 function flush(t::THeaderTransport)
-    # Flush write buffer (wbuf) which contains the payload
-    payload = transform(t, take!(t.wbuf))
-    payload_size = length(payload)
-
-    # Create a new IO buffer to hold the entire message including header
-    buf = make_header_message(t, payload)
+    # Flush write buffer (wbuf) which contains the payload. It is drained by reading from it,
+    # which leaves it its array for the next frame.
+    wbuf = t.wbuf
+    transforms = frame_transforms(t, bytesavailable(wbuf))
+    payload_size = bytesavailable(wbuf)
+
+    # Create a new IO buffer to hold the entire message including header, sent with one write
+    if isempty(transforms)
+        buf = make_header(t, payload_size, transforms)
+        write(buf, wbuf)
+    else
+        payload = transform(t, read(wbuf), transforms)
+        payload_size = length(payload)
+        buf = make_header_message(t, payload, transforms)
+    end
 
     message_length_offset = payload_size < Magic.MAX_FRAME_SIZE ? 4 : 12
     frame_size = bytesavailable(buf) - message_length_offset
@@ -706,13 +989,13 @@ function init_write_headers!(t::THeaderTransport)
 end
 
 """
-    make_header_transform_data(t::THeaderTransport)
+    make_header_transform_data(t::THeaderTransport, transforms=t.write_transforms)
 
 Return a buffer with transform id's for sending a header message.
 """
-function make_header_transform_data(t::THeaderTransport)
+function make_header_transform_data(t::THeaderTransport, transforms::Vector{TransformIDEnum}=t.write_transforms)
     buf = PipeBuffer()
-    for trans_id in t.write_transforms
+    for trans_id in transforms
         writeVarint(buf, trans_id)
     end
     debug_buffer("transform_data", buf)
@@ -733,13 +1016,13 @@ function make_header_info_data(t::THeaderTransport)
 end
 
 """
-    make_header_meta_data(t::THeaderTransport)
+    make_header_meta_data(t::THeaderTransport, transforms=t.write_transforms)
 
 Return a buffer with header meta data (just `proto_id` and `num_transforms`).
 """
-function make_header_meta_data(t::THeaderTransport)
+function make_header_meta_data(t::THeaderTransport, transforms::Vector{TransformIDEnum}=t.write_transforms)
     buf = PipeBuffer()
-    num_transforms = length(t.write_transforms)
+    num_transforms = length(transforms)
     writeVarint(buf, t.proto_id)
     writeVarint(buf, num_transforms)
     debug_buffer("header_data", buf)
@@ -750,7 +1033,7 @@ end
     calc_header_meta(transform_data::IOBuffer,
         info_data::IOBuffer,
         header_data::IOBuffer,
-        payload::Vector{UInt8},
+        payload_size::Integer,
     )
 
 Calculate some basic sizes for the header meta data.
@@ -759,7 +1042,7 @@ function calc_header_meta(
     transform_data::IOBuffer,
     info_data::IOBuffer,
     header_data::IOBuffer,
-    payload::Vector{UInt8},
+    payload_size::Integer,
 )
     header_size = bytesavailable(transform_data) + bytesavailable(info_data) +
         bytesavailable(header_data)
@@ -767,7 +1050,7 @@ function calc_header_meta(
     header_size += padding_size
     header_words = header_size ÷ 4
     # MAGIC(2) + FLAGS(2) + SEQ_ID(4) + HEADER_SIZE(2) = 10 bytes
-    message_size = length(payload) + header_size + 10
+    message_size = payload_size + header_size + 10
     return HeaderMeta(header_size, padding_size, header_words, message_size)
 end
 
@@ -793,18 +1076,19 @@ function make_header_top_part(t::THeaderTransport, header_meta::HeaderMeta)
 end
 
 """
-    make_header_message(t::THeaderTransport, payload::Vector{UInt8})
+    make_header(t::THeaderTransport, payload_size::Integer, transforms=t.write_transforms)
 
-Return a buffer with header message populated.
+Return a buffer with the header of a message, to be followed by a payload of `payload_size` bytes.
+`transforms` lists the transforms applied to the payload.
 """
-function make_header_message(t::THeaderTransport, payload::Vector{UInt8})
+function make_header(t::THeaderTransport, payload_size::Integer, transforms::Vector{TransformIDEnum}=t.write_transforms)
     init_write_headers!(t)
 
-    transform_data = make_header_transform_data(t)
+    transform_data = make_header_transform_data(t, transforms)
     info_data = make_header_info_data(t)
-    header_data = make_header_meta_data(t)
+    header_data = make_header_meta_data(t, transforms)
 
-    header_meta = calc_header_meta(transform_data, info_data, header_data, payload)
+    header_meta = calc_header_meta(transform_data, info_data, header_data, payload_size)
     top_part = make_header_top_part(t, header_meta)
 
     buf = PipeBuffer()
@@ -813,11 +1097,21 @@ function make_header_message(t::THeaderTransport, payload::Vector{UInt8})
     write(buf, take!(transform_data))
     write(buf, take!(info_data))
     write(buf, zeros(UInt8, header_meta.padding_size))
-    write(buf, payload)
 
     return buf
 end
 
+"""
+    make_header_message(t::THeaderTransport, payload::Vector{UInt8}, transforms=t.write_transforms)
+
+Return a buffer with header message populated. `transforms` lists the transforms applied to `payload`.
+"""
+function make_header_message(t::THeaderTransport, payload::Vector{UInt8}, transforms::Vector{TransformIDEnum}=t.write_transforms)
+    buf = make_header(t, length(payload), transforms)
+    write(buf, payload)
+    return buf
+end
+
 """
     flush_info_headers!(buf::IOBuffer, headers::HeadersType, info_id::InfoIDEnum)
 
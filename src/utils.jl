@@ -78,3 +78,46 @@ function transform_data(codec, data::Vector{UInt8})
     TranscodingStreams.initialize(codec_processor)
     return transcode(codec_processor, data)
 end
+
+"""
+    read_all(T, bytes::Vector{UInt8}; protocol=TCompactProtocol, threads=Threads.nthreads())
+
+Decode `bytes`, holding serialized messages of type `T` one after another, into a `Vector{T}`.
+Message boundaries are found first by skipping over the messages, then the messages are decoded
+in `threads` chunks concurrently, each with its own transport and protocol instance.
+"""
+function read_all(::Type{T}, bytes::Vector{UInt8}; protocol::Type{P}=TCompactProtocol, threads::Integer=Threads.nthreads()) where {T,P<:TProtocol}
+    starts = message_starts(T, bytes, protocol)
+    nmsgs = length(starts) - 1
+    result = Vector{T}(undef, nmsgs)
+    (nmsgs == 0) && return result
+
+    nchunks = clamp(threads, 1, nmsgs)
+    chunksz = cld(nmsgs, nchunks)
+    tasks = map(1:chunksz:nmsgs) do first
+        Threads.@spawn read_range!(result, bytes, protocol, starts, first:min(first+chunksz-1, nmsgs))
+    end
+    foreach(wait, tasks)
+    result
+end
+
+# offsets in `bytes` at which each message starts, followed by the offset past the last message
+function message_starts(::Type{T}, bytes::Vector{UInt8}, protocol::Type{P}) where {T,P<:TProtocol}
+    buf = IOBuffer(bytes)
+    p = protocol(TMemoryTransport(buf))
+    starts = Int[position(buf) + 1]
+    while !eof(buf)
+        skip(p, T)
+        push!(starts, position(buf) + 1)
+    end
+    starts
+end
+
+function read_range!(result::Vector{T}, bytes::Vector{UInt8}, protocol::Type{P}, starts::Vector{Int}, range::UnitRange{Int}) where {T,P<:TProtocol}
+    buf = seek(IOBuffer(bytes), starts[first(range)] - 1)
+    p = protocol(TMemoryTransport(buf))
+    for idx in range
+        result[idx] = read(p, T)
+    end
+    nothing
+end
@@ -0,0 +1,248 @@
+#
+# Autogenerated by Thrift Compiler (0.12.1)
+#
+# DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+
+
+
+# types encapsulating arguments and return values of method twice
+
+mutable struct twice_args_Counter <: Thrift.TTypedMsg
+  meta::ThriftMeta
+  x::Union{Nothing,Int32}
+  
+  function twice_args_Counter(; kwargs...)
+    obj = new(__meta__twice_args_Counter, nothing)
+    symdict = obj.meta.symdict
+    for nv in kwargs
+      fldname, fldval = nv
+      (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+      setproperty!(obj, fldname, fldval)
+    end
+    Thrift.setdefaultproperties!(obj)
+    obj
+  end
+end # mutable struct twice_args_Counter
+
+const __meta__twice_args_Counter = meta(twice_args_Counter,
+  Symbol[:x],
+  Type[Int32],
+  Symbol[],
+  Int[],
+  Dict{Symbol,Any}()
+)
+
+function Base.getproperty(obj::twice_args_Counter, name::Symbol)
+  if name === :x
+    return (Thrift.fieldvalue(obj, :x))::Int32
+  else
+    getfield(obj, name)
+  end
+end
+
+function Base.setproperty!(obj::twice_args_Counter, name::Symbol, val)
+  if name === :x
+    setfield!(obj, :x, isa(val, Int32) ? val : convert(Int32, val))
+  else
+    setfield!(obj, name, val)
+  end
+end
+
+meta(::Type{twice_args_Counter}) = __meta__twice_args_Counter
+
+Thrift.setdefaultproperties!(val::twice_args_Counter) = val
+
+function Thrift.read_container(p::TProtocol, val::twice_args_Counter)
+  Thrift.readStructBegin(p)
+  clear(val)
+  while true
+    (name, ttyp, id) = Thrift.readFieldBegin(p)
+    (ttyp == Thrift.TType.STOP) && break
+    if (id == 1) && (ttyp == Thrift.TType.I32)
+      val.x = Thrift.read(p, Int32)
+    else
+      Thrift.skip_value(p, ttyp)
+    end
+    Thrift.readFieldEnd(p)
+  end
+  Thrift.readStructEnd(p)
+  Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::twice_args_Counter)
+  Thrift.writeStructBegin(p, "twice_args_Counter")
+  if hasproperty(val, :x)
+    Thrift.writeFieldBegin(p, "x", Thrift.TType.I32, 1)
+    Thrift.write(p, val.x)
+    Thrift.writeFieldEnd(p)
+  else
+    error("required field x not populated")
+  end
+  Thrift.writeFieldStop(p)
+  Thrift.writeStructEnd(p)
+  nothing
+end
+
+
+
+mutable struct twice_result_Counter <: Thrift.TTypedMsg
+  meta::ThriftMeta
+  success::Union{Nothing,Int32}
+  
+  function twice_result_Counter(; kwargs...)
+    obj = new(__meta__twice_result_Counter, nothing)
+    symdict = obj.meta.symdict
+    for nv in kwargs
+      fldname, fldval = nv
+      (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+      setproperty!(obj, fldname, fldval)
+    end
+    Thrift.setdefaultproperties!(obj)
+    obj
+  end
+end # mutable struct twice_result_Counter
+
+const __meta__twice_result_Counter = meta(twice_result_Counter,
+  Symbol[:success],
+  Type[Int32],
+  Symbol[],
+  Int[0],
+  Dict{Symbol,Any}()
+)
+
+function Base.getproperty(obj::twice_result_Counter, name::Symbol)
+  if name === :success
+    return (Thrift.fieldvalue(obj, :success))::Int32
+  else
+    getfield(obj, name)
+  end
+end
+
+function Base.setproperty!(obj::twice_result_Counter, name::Symbol, val)
+  if name === :success
+    setfield!(obj, :success, isa(val, Int32) ? val : convert(Int32, val))
+  else
+    setfield!(obj, name, val)
+  end
+end
+
+meta(::Type{twice_result_Counter}) = __meta__twice_result_Counter
+
+Thrift.setdefaultproperties!(val::twice_result_Counter) = val
+
+function Thrift.read_container(p::TProtocol, val::twice_result_Counter)
+  Thrift.readStructBegin(p)
+  clear(val)
+  while true
+    (name, ttyp, id) = Thrift.readFieldBegin(p)
+    (ttyp == Thrift.TType.STOP) && break
+    if (id == 0) && (ttyp == Thrift.TType.I32)
+      val.success = Thrift.read(p, Int32)
+    else
+      Thrift.skip_value(p, ttyp)
+    end
+    Thrift.readFieldEnd(p)
+  end
+  Thrift.readStructEnd(p)
+  Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::twice_result_Counter)
+  Thrift.writeStructBegin(p, "twice_result_Counter")
+  if hasproperty(val, :success)
+    Thrift.writeFieldBegin(p, "success", Thrift.TType.I32, 0)
+    Thrift.write(p, val.success)
+    Thrift.writeFieldEnd(p)
+  else
+    error("required field success not populated")
+  end
+  Thrift.writeFieldStop(p)
+  Thrift.writeStructEnd(p)
+  nothing
+end
+
+
+
+
+# Processor for Counter service (to be used in server implementation)
+mutable struct CounterProcessor <: TProcessor
+  tp::ThriftProcessor
+  function CounterProcessor()
+    p = new(ThriftProcessor())
+    handle(p.tp, __handler__twice_Counter)
+    p
+  end
+end # mutable struct CounterProcessor
+_twice(inp::twice_args_Counter, outp::twice_result_Counter=twice_result_Counter()) = (outp.success = twice(inp.x); outp)
+
+const __handler__twice_Counter = ThriftHandler("twice", _twice, twice_args_Counter, twice_result_Counter)
+
+function process(p::CounterProcessor, inp::TProtocol, outp::TProtocol, outlock::ReentrantLock...)
+  (name, typ, seqid) = Thrift.readMessageBegin(inp)
+  len = sizeof(name)
+  if len == 5
+    (name == "twice") && (return Thrift._process(p.tp, inp, outp, name, typ, seqid, __handler__twice_Counter, outlock...))
+  end
+  Thrift._unknown(inp, outp, name, seqid, outlock...)
+end
+distribute(p::CounterProcessor) = distribute(p.tp)
+recycle(p::CounterProcessor, use_pool::Bool=true) = recycle(p.tp, use_pool)
+instrument(p::CounterProcessor, m::Union{Nothing,ThriftMetrics}=ThriftMetrics()) = instrument(p.tp, m)
+metrics(p::CounterProcessor) = metrics(p.tp)
+
+
+# Server side methods to be defined by user:
+# function twice(x::Int32)
+#     # returns Int32
+
+
+# Client implementation for Counter service
+mutable struct CounterClient <: CounterClientBase
+  p::TProtocol
+  seqid::Int32
+  CounterClient(p::TProtocol) = new(p, 0)
+end # mutable struct CounterClient
+
+# Client callable method for twice
+function twice(c::CounterClientBase, x::Int32)
+  p = c.p
+  c.seqid = (c.seqid < (2^31-1)) ? (c.seqid+1) : 0
+  Thrift.writeMessageBegin(p, "twice", Thrift.MessageType.CALL, c.seqid)
+  inp = twice_args_Counter()
+  inp.x = x
+  Thrift.write(p, inp)
+  Thrift.writeMessageEnd(p)
+  Thrift.flush(p.t)
+  
+  (fname, mtype, rseqid) = Thrift.readMessageBegin(p)
+  (mtype == Thrift.MessageType.EXCEPTION) && throw(Thrift.read(p, Thrift.TApplicationException()))
+  outp = Thrift.read(p, twice_result_Counter())
+  Thrift.readMessageEnd(p)
+  (rseqid != c.seqid) && throw(Thrift.TApplicationException(; typ=ApplicationExceptionType.BAD_SEQUENCE_ID, message="response sequence id $rseqid did not match request ($(c.seqid))"))
+  hasproperty(outp, :success) && (return outp.success)
+  throw(Thrift.TApplicationException(; typ=Thrift.ApplicationExceptionType.MISSING_RESULT, message="retrieve failed: unknown result"))
+end # function twice
+
+
+
+# Async client implementation for Counter service
+# Calls return a Task that gives the result (or throws the exception) when fetched.
+mutable struct CounterAsyncClient <: CounterAsyncClientBase
+  conn::ThriftAsyncConnection
+  CounterAsyncClient(p::TProtocol) = new(ThriftAsyncConnection(p))
+  CounterAsyncClient(inp::TProtocol, outp::TProtocol) = new(ThriftAsyncConnection(inp, outp))
+  CounterAsyncClient(conn::ThriftAsyncConnection) = new(conn)
+end # mutable struct CounterAsyncClient
+
+# Async client callable method for twice
+function twice(c::CounterAsyncClientBase, x::Int32)
+  inp = twice_args_Counter()
+  inp.x = x
+  ch = Thrift.call(c.conn, "twice", Thrift.MessageType.CALL, inp, twice_result_Counter())
+  @async begin
+    outp = Thrift.reply(ch)
+    hasproperty(outp, :success) && (return outp.success)
+    throw(Thrift.TApplicationException(; typ=Thrift.ApplicationExceptionType.MISSING_RESULT, message="retrieve failed: unknown result"))
+  end
+end # function twice
+
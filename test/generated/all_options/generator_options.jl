@@ -0,0 +1,34 @@
+#
+# Autogenerated by Thrift Compiler (0.12.1)
+#
+# DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+
+
+module generator_options
+
+using Thrift
+import Thrift.process, Thrift.meta, Thrift.distribute, Thrift.recycle, Thrift.instrument, Thrift.metrics
+
+
+
+
+export meta
+export Level # enum
+export Record # struct
+export Defaults # struct
+export Leveled # struct
+export Nested # struct
+export AllKinds # struct
+export CounterProcessor, CounterClient, CounterClientBase, CounterAsyncClient, CounterAsyncClientBase, twice, __handler__twice_Counter # service Counter
+export GreeterProcessor, GreeterClient, GreeterClientBase, GreeterAsyncClient, GreeterAsyncClientBase, greet, __handler__greet_Greeter # service Greeter
+
+include("generator_options_types.jl")
+include("generator_options_constants.jl")
+include("generator_options_impl.jl")  # server methods to be hand coded
+include("Counter.jl")
+include("Greeter.jl")
+
+include("generator_options_precompile.jl")
+_precompile_()
+
+end # module generator_options
@@ -0,0 +1,632 @@
+#
+# Autogenerated by Thrift Compiler (0.12.1)
+#
+# DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+
+baremodule Level
+import Base: @enum
+@enum T::Int32 begin
+  LOW = 1
+  HIGH = 2
+end
+const MINIMUM = LOW
+end # module Level
+
+
+mutable struct Record <: Thrift.TTypedMsg
+  meta::ThriftMeta
+  id::Union{Nothing,Int32}
+  label::Union{Nothing,String}
+  tags::Union{Nothing,Vector{String}}
+  counts::Union{Nothing,Dict{String,Int64}}
+  
+  function Record(; kwargs...)
+    obj = new(__meta__Record, nothing, nothing, nothing, nothing)
+    symdict = obj.meta.symdict
+    for nv in kwargs
+      fldname, fldval = nv
+      (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+      setproperty!(obj, fldname, fldval)
+    end
+    Thrift.setdefaultproperties!(obj)
+    obj
+  end
+end # mutable struct Record
+
+const __meta__Record = meta(Record,
+  Symbol[:id,:label,:tags,:counts],
+  Type[Int32,String,Vector{String},Dict{String,Int64}],
+  Symbol[:label,:tags,:counts],
+  Int[],
+  Dict{Symbol,Any}()
+)
+
+function Base.getproperty(obj::Record, name::Symbol)
+  if name === :id
+    return (Thrift.fieldvalue(obj, :id))::Int32
+  elseif name === :label
+    return (Thrift.fieldvalue(obj, :label))::String
+  elseif name === :tags
+    return (Thrift.fieldvalue(obj, :tags))::Vector{String}
+  elseif name === :counts
+    return (Thrift.fieldvalue(obj, :counts))::Dict{String,Int64}
+  else
+    getfield(obj, name)
+  end
+end
+
+function Base.setproperty!(obj::Record, name::Symbol, val)
+  if name === :id
+    setfield!(obj, :id, isa(val, Int32) ? val : convert(Int32, val))
+  elseif name === :label
+    setfield!(obj, :label, isa(val, String) ? val : convert(String, val))
+  elseif name === :tags
+    setfield!(obj, :tags, isa(val, Vector{String}) ? val : convert(Vector{String}, val))
+  elseif name === :counts
+    setfield!(obj, :counts, isa(val, Dict{String,Int64}) ? val : convert(Dict{String,Int64}, val))
+  else
+    setfield!(obj, name, val)
+  end
+end
+
+meta(::Type{Record}) = __meta__Record
+
+Thrift.setdefaultproperties!(val::Record) = val
+
+function Thrift.read_container(p::TProtocol, val::Record)
+  Thrift.readStructBegin(p)
+  clear(val)
+  while true
+    (name, ttyp, id) = Thrift.readFieldBegin(p)
+    (ttyp == Thrift.TType.STOP) && break
+    if (id == 1) && (ttyp == Thrift.TType.I32)
+      val.id = Thrift.read(p, Int32)
+    elseif (id == 2) && (ttyp == Thrift.TType.STRING)
+      val.label = Thrift.read(p, String)
+    elseif (id == 3) && (ttyp == Thrift.TType.LIST)
+      val.tags = Thrift.read_container(p, Vector{String}())
+    elseif (id == 4) && (ttyp == Thrift.TType.MAP)
+      val.counts = Thrift.read_container(p, Dict{String,Int64}())
+    else
+      Thrift.skip_value(p, ttyp)
+    end
+    Thrift.readFieldEnd(p)
+  end
+  Thrift.readStructEnd(p)
+  Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::Record)
+  Thrift.writeStructBegin(p, "Record")
+  if hasproperty(val, :id)
+    Thrift.writeFieldBegin(p, "id", Thrift.TType.I32, 1)
+    Thrift.write(p, val.id)
+    Thrift.writeFieldEnd(p)
+  else
+    error("required field id not populated")
+  end
+  if hasproperty(val, :label)
+    Thrift.writeFieldBegin(p, "label", Thrift.TType.STRING, 2)
+    Thrift.write(p, val.label)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :tags)
+    Thrift.writeFieldBegin(p, "tags", Thrift.TType.LIST, 3)
+    Thrift.write(p, val.tags)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :counts)
+    Thrift.writeFieldBegin(p, "counts", Thrift.TType.MAP, 4)
+    Thrift.write(p, val.counts)
+    Thrift.writeFieldEnd(p)
+  end
+  Thrift.writeFieldStop(p)
+  Thrift.writeStructEnd(p)
+  nothing
+end
+
+
+mutable struct Defaults <: Thrift.TTypedMsg
+  meta::ThriftMeta
+  nums::Union{Nothing,Vector{Int32}}
+  counts::Union{Nothing,Dict{String,Int32}}
+  limit::Union{Nothing,Int32}
+  
+  function Defaults(; kwargs...)
+    obj = new(__meta__Defaults, nothing, nothing, nothing)
+    symdict = obj.meta.symdict
+    for nv in kwargs
+      fldname, fldval = nv
+      (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+      setproperty!(obj, fldname, fldval)
+    end
+    Thrift.setdefaultproperties!(obj)
+    obj
+  end
+end # mutable struct Defaults
+
+const __meta__Defaults = meta(Defaults,
+  Symbol[:nums,:counts,:limit],
+  Type[Vector{Int32},Dict{String,Int32},Int32],
+  Symbol[:nums,:counts,:limit],
+  Int[],
+  Dict{Symbol,Any}(:nums => Int32[1, 2], :counts => Dict("a" => Int32(1)), :limit => Int32(10))
+)
+
+function Base.getproperty(obj::Defaults, name::Symbol)
+  if name === :nums
+    return (Thrift.fieldvalue(obj, :nums))::Vector{Int32}
+  elseif name === :counts
+    return (Thrift.fieldvalue(obj, :counts))::Dict{String,Int32}
+  elseif name === :limit
+    return (Thrift.fieldvalue(obj, :limit))::Int32
+  else
+    getfield(obj, name)
+  end
+end
+
+function Base.setproperty!(obj::Defaults, name::Symbol, val)
+  if name === :nums
+    setfield!(obj, :nums, isa(val, Vector{Int32}) ? val : convert(Vector{Int32}, val))
+  elseif name === :counts
+    setfield!(obj, :counts, isa(val, Dict{String,Int32}) ? val : convert(Dict{String,Int32}, val))
+  elseif name === :limit
+    setfield!(obj, :limit, isa(val, Int32) ? val : convert(Int32, val))
+  else
+    setfield!(obj, name, val)
+  end
+end
+
+meta(::Type{Defaults}) = __meta__Defaults
+
+function Thrift.setdefaultproperties!(val::Defaults)
+  hasproperty(val, :nums) || (val.nums = Int32[1, 2])
+  hasproperty(val, :counts) || (val.counts = Dict("a" => Int32(1)))
+  hasproperty(val, :limit) || (val.limit = Int32(10))
+  val
+end
+
+function Thrift.read_container(p::TProtocol, val::Defaults)
+  Thrift.readStructBegin(p)
+  clear(val)
+  while true
+    (name, ttyp, id) = Thrift.readFieldBegin(p)
+    (ttyp == Thrift.TType.STOP) && break
+    if (id == 1) && (ttyp == Thrift.TType.LIST)
+      val.nums = Thrift.read_container(p, Vector{Int32}())
+    elseif (id == 2) && (ttyp == Thrift.TType.MAP)
+      val.counts = Thrift.read_container(p, Dict{String,Int32}())
+    elseif (id == 3) && (ttyp == Thrift.TType.I32)
+      val.limit = Thrift.read(p, Int32)
+    else
+      Thrift.skip_value(p, ttyp)
+    end
+    Thrift.readFieldEnd(p)
+  end
+  Thrift.readStructEnd(p)
+  Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::Defaults)
+  Thrift.writeStructBegin(p, "Defaults")
+  if hasproperty(val, :nums)
+    Thrift.writeFieldBegin(p, "nums", Thrift.TType.LIST, 1)
+    Thrift.write(p, val.nums)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :counts)
+    Thrift.writeFieldBegin(p, "counts", Thrift.TType.MAP, 2)
+    Thrift.write(p, val.counts)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :limit)
+    Thrift.writeFieldBegin(p, "limit", Thrift.TType.I32, 3)
+    Thrift.write(p, val.limit)
+    Thrift.writeFieldEnd(p)
+  end
+  Thrift.writeFieldStop(p)
+  Thrift.writeStructEnd(p)
+  nothing
+end
+
+
+mutable struct Leveled <: Thrift.TTypedMsg
+  meta::ThriftMeta
+  level::Union{Nothing,Level.T}
+  
+  function Leveled(; kwargs...)
+    obj = new(__meta__Leveled, nothing)
+    symdict = obj.meta.symdict
+    for nv in kwargs
+      fldname, fldval = nv
+      (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+      setproperty!(obj, fldname, fldval)
+    end
+    Thrift.setdefaultproperties!(obj)
+    obj
+  end
+end # mutable struct Leveled
+
+const __meta__Leveled = meta(Leveled,
+  Symbol[:level],
+  Type[Level.T],
+  Symbol[:level],
+  Int[],
+  Dict{Symbol,Any}()
+)
+
+function Base.getproperty(obj::Leveled, name::Symbol)
+  if name === :level
+    return (Thrift.fieldvalue(obj, :level))::Level.T
+  else
+    getfield(obj, name)
+  end
+end
+
+function Base.setproperty!(obj::Leveled, name::Symbol, val)
+  if name === :level
+    setfield!(obj, :level, isa(val, Level.T) ? val : convert(Level.T, val))
+  else
+    setfield!(obj, name, val)
+  end
+end
+
+meta(::Type{Leveled}) = __meta__Leveled
+
+Thrift.setdefaultproperties!(val::Leveled) = val
+
+function Thrift.read_container(p::TProtocol, val::Leveled)
+  Thrift.readStructBegin(p)
+  clear(val)
+  while true
+    (name, ttyp, id) = Thrift.readFieldBegin(p)
+    (ttyp == Thrift.TType.STOP) && break
+    if (id == 1) && (ttyp == Thrift.TType.I32)
+      val.level = Thrift.read(p, Level.T)
+    else
+      Thrift.skip_value(p, ttyp)
+    end
+    Thrift.readFieldEnd(p)
+  end
+  Thrift.readStructEnd(p)
+  Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::Leveled)
+  Thrift.writeStructBegin(p, "Leveled")
+  if hasproperty(val, :level)
+    Thrift.writeFieldBegin(p, "level", Thrift.TType.I32, 1)
+    Thrift.write(p, val.level)
+    Thrift.writeFieldEnd(p)
+  end
+  Thrift.writeFieldStop(p)
+  Thrift.writeStructEnd(p)
+  nothing
+end
+
+
+mutable struct Nested <: Thrift.TTypedMsg
+  meta::ThriftMeta
+  num::Union{Nothing,Int32}
+  
+  function Nested(; kwargs...)
+    obj = new(__meta__Nested, nothing)
+    symdict = obj.meta.symdict
+    for nv in kwargs
+      fldname, fldval = nv
+      (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+      setproperty!(obj, fldname, fldval)
+    end
+    Thrift.setdefaultproperties!(obj)
+    obj
+  end
+end # mutable struct Nested
+
+const __meta__Nested = meta(Nested,
+  Symbol[:num],
+  Type[Int32],
+  Symbol[:num],
+  Int[],
+  Dict{Symbol,Any}()
+)
+
+function Base.getproperty(obj::Nested, name::Symbol)
+  if name === :num
+    return (Thrift.fieldvalue(obj, :num))::Int32
+  else
+    getfield(obj, name)
+  end
+end
+
+function Base.setproperty!(obj::Nested, name::Symbol, val)
+  if name === :num
+    setfield!(obj, :num, isa(val, Int32) ? val : convert(Int32, val))
+  else
+    setfield!(obj, name, val)
+  end
+end
+
+meta(::Type{Nested}) = __meta__Nested
+
+Thrift.setdefaultproperties!(val::Nested) = val
+
+function Thrift.read_container(p::TProtocol, val::Nested)
+  Thrift.readStructBegin(p)
+  clear(val)
+  while true
+    (name, ttyp, id) = Thrift.readFieldBegin(p)
+    (ttyp == Thrift.TType.STOP) && break
+    if (id == 1) && (ttyp == Thrift.TType.I32)
+      val.num = Thrift.read(p, Int32)
+    else
+      Thrift.skip_value(p, ttyp)
+    end
+    Thrift.readFieldEnd(p)
+  end
+  Thrift.readStructEnd(p)
+  Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::Nested)
+  Thrift.writeStructBegin(p, "Nested")
+  if hasproperty(val, :num)
+    Thrift.writeFieldBegin(p, "num", Thrift.TType.I32, 1)
+    Thrift.write(p, val.num)
+    Thrift.writeFieldEnd(p)
+  end
+  Thrift.writeFieldStop(p)
+  Thrift.writeStructEnd(p)
+  nothing
+end
+
+
+mutable struct AllKinds <: Thrift.TTypedMsg
+  meta::ThriftMeta
+  flag::Union{Nothing,Bool}
+  tiny::Union{Nothing,UInt8}
+  small::Union{Nothing,Int16}
+  num::Union{Nothing,Int32}
+  big::Union{Nothing,Int64}
+  real::Union{Nothing,Float64}
+  text::Union{Nothing,String}
+  blob::Union{Nothing,Thrift.TBinaryView}
+  nums::Union{Nothing,Vector{Int64}}
+  names::Union{Nothing,Set{String}}
+  blobs::Union{Nothing,Dict{String,Thrift.TBinaryView}}
+  nesteds::Union{Nothing,Vector{Nested}}
+  nested::Union{Nothing,Nested}
+  level::Union{Nothing,Level.T}
+  blob_list::Union{Nothing,Vector{Thrift.TBinaryView}}
+  
+  function AllKinds(; kwargs...)
+    obj = new(__meta__AllKinds, nothing, nothing, nothing, nothing, nothing, nothing, nothing, nothing, nothing, nothing, nothing, nothing, nothing, nothing, nothing)
+    symdict = obj.meta.symdict
+    for nv in kwargs
+      fldname, fldval = nv
+      (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+      setproperty!(obj, fldname, fldval)
+    end
+    Thrift.setdefaultproperties!(obj)
+    obj
+  end
+end # mutable struct AllKinds
+
+const __meta__AllKinds = meta(AllKinds,
+  Symbol[:flag,:tiny,:small,:num,:big,:real,:text,:blob,:nums,:names,:blobs,:nesteds,:nested,:level,:blob_list],
+  Type[Bool,UInt8,Int16,Int32,Int64,Float64,String,Thrift.TBinaryView,Vector{Int64},Set{String},Dict{String,Thrift.TBinaryView},Vector{Nested},Nested,Level.T,Vector{Thrift.TBinaryView}],
+  Symbol[:flag,:tiny,:small,:num,:big,:real,:text,:blob,:nums,:names,:blobs,:nesteds,:nested,:level,:blob_list],
+  Int[1,2,3,4,5,6,7,8,9,10,11,12,13,14,16],
+  Dict{Symbol,Any}()
+)
+
+function Base.getproperty(obj::AllKinds, name::Symbol)
+  if name === :flag
+    return (Thrift.fieldvalue(obj, :flag))::Bool
+  elseif name === :tiny
+    return (Thrift.fieldvalue(obj, :tiny))::UInt8
+  elseif name === :small
+    return (Thrift.fieldvalue(obj, :small))::Int16
+  elseif name === :num
+    return (Thrift.fieldvalue(obj, :num))::Int32
+  elseif name === :big
+    return (Thrift.fieldvalue(obj, :big))::Int64
+  elseif name === :real
+    return (Thrift.fieldvalue(obj, :real))::Float64
+  elseif name === :text
+    return (Thrift.fieldvalue(obj, :text))::String
+  elseif name === :blob
+    return (Thrift.fieldvalue(obj, :blob))::Thrift.TBinaryView
+  elseif name === :nums
+    return (Thrift.fieldvalue(obj, :nums))::Vector{Int64}
+  elseif name === :names
+    return (Thrift.fieldvalue(obj, :names))::Set{String}
+  elseif name === :blobs
+    return (Thrift.fieldvalue(obj, :blobs))::Dict{String,Thrift.TBinaryView}
+  elseif name === :nesteds
+    return (Thrift.fieldvalue(obj, :nesteds))::Vector{Nested}
+  elseif name === :nested
+    return (Thrift.fieldvalue(obj, :nested))::Nested
+  elseif name === :level
+    return (Thrift.fieldvalue(obj, :level))::Level.T
+  elseif name === :blob_list
+    return (Thrift.fieldvalue(obj, :blob_list))::Vector{Thrift.TBinaryView}
+  else
+    getfield(obj, name)
+  end
+end
+
+function Base.setproperty!(obj::AllKinds, name::Symbol, val)
+  if name === :flag
+    setfield!(obj, :flag, isa(val, Bool) ? val : convert(Bool, val))
+  elseif name === :tiny
+    setfield!(obj, :tiny, isa(val, UInt8) ? val : convert(UInt8, val))
+  elseif name === :small
+    setfield!(obj, :small, isa(val, Int16) ? val : convert(Int16, val))
+  elseif name === :num
+    setfield!(obj, :num, isa(val, Int32) ? val : convert(Int32, val))
+  elseif name === :big
+    setfield!(obj, :big, isa(val, Int64) ? val : convert(Int64, val))
+  elseif name === :real
+    setfield!(obj, :real, isa(val, Float64) ? val : convert(Float64, val))
+  elseif name === :text
+    setfield!(obj, :text, isa(val, String) ? val : convert(String, val))
+  elseif name === :blob
+    setfield!(obj, :blob, isa(val, Thrift.TBinaryView) ? val : convert(Thrift.TBinaryView, val))
+  elseif name === :nums
+    setfield!(obj, :nums, isa(val, Vector{Int64}) ? val : convert(Vector{Int64}, val))
+  elseif name === :names
+    setfield!(obj, :names, isa(val, Set{String}) ? val : convert(Set{String}, val))
+  elseif name === :blobs
+    setfield!(obj, :blobs, isa(val, Dict{String,Thrift.TBinaryView}) ? val : convert(Dict{String,Thrift.TBinaryView}, val))
+  elseif name === :nesteds
+    setfield!(obj, :nesteds, isa(val, Vector{Nested}) ? val : convert(Vector{Nested}, val))
+  elseif name === :nested
+    setfield!(obj, :nested, isa(val, Nested) ? val : convert(Nested, val))
+  elseif name === :level
+    setfield!(obj, :level, isa(val, Level.T) ? val : convert(Level.T, val))
+  elseif name === :blob_list
+    setfield!(obj, :blob_list, isa(val, Vector{Thrift.TBinaryView}) ? val : convert(Vector{Thrift.TBinaryView}, val))
+  else
+    setfield!(obj, name, val)
+  end
+end
+
+meta(::Type{AllKinds}) = __meta__AllKinds
+
+Thrift.setdefaultproperties!(val::AllKinds) = val
+
+function Thrift.read_container(p::TProtocol, val::AllKinds)
+  Thrift.readStructBegin(p)
+  clear(val)
+  while true
+    (name, ttyp, id) = Thrift.readFieldBegin(p)
+    (ttyp == Thrift.TType.STOP) && break
+    if (id == 1) && (ttyp == Thrift.TType.BOOL)
+      val.flag = Thrift.read(p, Bool)
+    elseif (id == 2) && (ttyp == Thrift.TType.BYTE)
+      val.tiny = Thrift.read(p, UInt8)
+    elseif (id == 3) && (ttyp == Thrift.TType.I16)
+      val.small = Thrift.read(p, Int16)
+    elseif (id == 4) && (ttyp == Thrift.TType.I32)
+      val.num = Thrift.read(p, Int32)
+    elseif (id == 5) && (ttyp == Thrift.TType.I64)
+      val.big = Thrift.read(p, Int64)
+    elseif (id == 6) && (ttyp == Thrift.TType.DOUBLE)
+      val.real = Thrift.read(p, Float64)
+    elseif (id == 7) && (ttyp == Thrift.TType.STRING)
+      val.text = Thrift.read(p, String)
+    elseif (id == 8) && (ttyp == Thrift.TType.STRING)
+      val.blob = Thrift.read(p, Thrift.TBinaryView)
+    elseif (id == 9) && (ttyp == Thrift.TType.LIST)
+      val.nums = Thrift.read_container(p, Vector{Int64}())
+    elseif (id == 10) && (ttyp == Thrift.TType.SET)
+      val.names = Thrift.read_container(p, Set{String}())
+    elseif (id == 11) && (ttyp == Thrift.TType.MAP)
+      val.blobs = Thrift.read_container(p, Dict{String,Thrift.TBinaryView}())
+    elseif (id == 12) && (ttyp == Thrift.TType.LIST)
+      val.nesteds = Thrift.read_container(p, Vector{Nested}())
+    elseif (id == 13) && (ttyp == Thrift.TType.STRUCT)
+      val.nested = Thrift.read_container(p, Nested())
+    elseif (id == 14) && (ttyp == Thrift.TType.I32)
+      val.level = Thrift.read(p, Level.T)
+    elseif (id == 16) && (ttyp == Thrift.TType.LIST)
+      val.blob_list = Thrift.read_container(p, Vector{Thrift.TBinaryView}())
+    else
+      Thrift.skip_value(p, ttyp)
+    end
+    Thrift.readFieldEnd(p)
+  end
+  Thrift.readStructEnd(p)
+  Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::AllKinds)
+  Thrift.writeStructBegin(p, "AllKinds")
+  if hasproperty(val, :flag)
+    Thrift.writeFieldBegin(p, "flag", Thrift.TType.BOOL, 1)
+    Thrift.writeBool(p, val.flag)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :tiny)
+    Thrift.writeFieldBegin(p, "tiny", Thrift.TType.BYTE, 2)
+    Thrift.write(p, val.tiny)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :small)
+    Thrift.writeFieldBegin(p, "small", Thrift.TType.I16, 3)
+    Thrift.write(p, val.small)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :num)
+    Thrift.writeFieldBegin(p, "num", Thrift.TType.I32, 4)
+    Thrift.write(p, val.num)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :big)
+    Thrift.writeFieldBegin(p, "big", Thrift.TType.I64, 5)
+    Thrift.write(p, val.big)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :real)
+    Thrift.writeFieldBegin(p, "real", Thrift.TType.DOUBLE, 6)
+    Thrift.write(p, val.real)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :text)
+    Thrift.writeFieldBegin(p, "text", Thrift.TType.STRING, 7)
+    Thrift.write(p, val.text)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :blob)
+    Thrift.writeFieldBegin(p, "blob", Thrift.TType.STRING, 8)
+    Thrift.write(p, val.blob, true)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :nums)
+    Thrift.writeFieldBegin(p, "nums", Thrift.TType.LIST, 9)
+    Thrift.write(p, val.nums)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :names)
+    Thrift.writeFieldBegin(p, "names", Thrift.TType.SET, 10)
+    Thrift.write(p, val.names)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :blobs)
+    Thrift.writeFieldBegin(p, "blobs", Thrift.TType.MAP, 11)
+    Thrift.write(p, val.blobs)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :nesteds)
+    Thrift.writeFieldBegin(p, "nesteds", Thrift.TType.LIST, 12)
+    Thrift.write(p, val.nesteds)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :nested)
+    Thrift.writeFieldBegin(p, "nested", Thrift.TType.STRUCT, 13)
+    Thrift.write(p, val.nested)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :level)
+    Thrift.writeFieldBegin(p, "level", Thrift.TType.I32, 14)
+    Thrift.write(p, val.level)
+    Thrift.writeFieldEnd(p)
+  end
+  if hasproperty(val, :blob_list)
+    Thrift.writeFieldBegin(p, "blob_list", Thrift.TType.LIST, 16)
+    Thrift.write(p, val.blob_list)
+    Thrift.writeFieldEnd(p)
+  end
+  Thrift.writeFieldStop(p)
+  Thrift.writeStructEnd(p)
+  nothing
+end
+
+
+abstract type CounterClientBase end
+
+abstract type CounterAsyncClientBase end
+
+const GreeterClientBase = CounterClientBase
+
+const GreeterAsyncClientBase = CounterAsyncClientBase
@@ -0,0 +1,216 @@
+#
+# Autogenerated by Thrift Compiler (0.12.1)
+#
+# DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+
+# service extends Counter
+
+
+# types encapsulating arguments and return values of method greet
+
+mutable struct greet_args_Greeter <: Thrift.TMsg
+  meta::ThriftMeta
+  values::Dict{Symbol,Any}
+  
+  function greet_args_Greeter(; kwargs...)
+    obj = new(__meta__greet_args_Greeter, Dict{Symbol,Any}())
+    values = obj.values
+    symdict = obj.meta.symdict
+    for nv in kwargs
+      fldname, fldval = nv
+      fldtype = symdict[fldname].jtype
+      (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+      values[fldname] = isa(fldval, fldtype) ? fldval : convert(fldtype, fldval)
+    end
+    Thrift.setdefaultproperties!(obj)
+    obj
+  end
+end # mutable struct greet_args_Greeter
+
+const __meta__greet_args_Greeter = meta(greet_args_Greeter,
+  Symbol[:name],
+  Type[String],
+  Symbol[],
+  Int[],
+  Dict{Symbol,Any}()
+)
+
+function Base.getproperty(obj::greet_args_Greeter, name::Symbol)
+  if name === :name
+    return (obj.values[name])::String
+  else
+    getfield(obj, name)
+  end
+end
+
+meta(::Type{greet_args_Greeter}) = __meta__greet_args_Greeter
+
+Thrift.setdefaultproperties!(val::greet_args_Greeter) = val
+
+function Thrift.read_container(p::TProtocol, val::greet_args_Greeter)
+  Thrift.readStructBegin(p)
+  clear(val)
+  while true
+    (name, ttyp, id) = Thrift.readFieldBegin(p)
+    (ttyp == Thrift.TType.STOP) && break
+    if (id == 1) && (ttyp == Thrift.TType.STRING)
+      val.name = Thrift.read(p, String)
+    else
+      Thrift.skip_value(p, ttyp)
+    end
+    Thrift.readFieldEnd(p)
+  end
+  Thrift.readStructEnd(p)
+  Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::greet_args_Greeter)
+  Thrift.writeStructBegin(p, "greet_args_Greeter")
+  if hasproperty(val, :name)
+    Thrift.writeFieldBegin(p, "name", Thrift.TType.STRING, 1)
+    Thrift.write(p, val.name)
+    Thrift.writeFieldEnd(p)
+  else
+    error("required field name not populated")
+  end
+  Thrift.writeFieldStop(p)
+  Thrift.writeStructEnd(p)
+  nothing
+end
+
+
+
+mutable struct greet_result_Greeter <: Thrift.TMsg
+  meta::ThriftMeta
+  values::Dict{Symbol,Any}
+  
+  function greet_result_Greeter(; kwargs...)
+    obj = new(__meta__greet_result_Greeter, Dict{Symbol,Any}())
+    values = obj.values
+    symdict = obj.meta.symdict
+    for nv in kwargs
+      fldname, fldval = nv
+      fldtype = symdict[fldname].jtype
+      (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+      values[fldname] = isa(fldval, fldtype) ? fldval : convert(fldtype, fldval)
+    end
+    Thrift.setdefaultproperties!(obj)
+    obj
+  end
+end # mutable struct greet_result_Greeter
+
+const __meta__greet_result_Greeter = meta(greet_result_Greeter,
+  Symbol[:success],
+  Type[String],
+  Symbol[],
+  Int[0],
+  Dict{Symbol,Any}()
+)
+
+function Base.getproperty(obj::greet_result_Greeter, name::Symbol)
+  if name === :success
+    return (obj.values[name])::String
+  else
+    getfield(obj, name)
+  end
+end
+
+meta(::Type{greet_result_Greeter}) = __meta__greet_result_Greeter
+
+Thrift.setdefaultproperties!(val::greet_result_Greeter) = val
+
+function Thrift.read_container(p::TProtocol, val::greet_result_Greeter)
+  Thrift.readStructBegin(p)
+  clear(val)
+  while true
+    (name, ttyp, id) = Thrift.readFieldBegin(p)
+    (ttyp == Thrift.TType.STOP) && break
+    if (id == 0) && (ttyp == Thrift.TType.STRING)
+      val.success = Thrift.read(p, String)
+    else
+      Thrift.skip_value(p, ttyp)
+    end
+    Thrift.readFieldEnd(p)
+  end
+  Thrift.readStructEnd(p)
+  Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::greet_result_Greeter)
+  Thrift.writeStructBegin(p, "greet_result_Greeter")
+  if hasproperty(val, :success)
+    Thrift.writeFieldBegin(p, "success", Thrift.TType.STRING, 0)
+    Thrift.write(p, val.success)
+    Thrift.writeFieldEnd(p)
+  else
+    error("required field success not populated")
+  end
+  Thrift.writeFieldStop(p)
+  Thrift.writeStructEnd(p)
+  nothing
+end
+
+
+
+
+# Processor for Greeter service (to be used in server implementation)
+mutable struct GreeterProcessor <: TProcessor
+  tp::ThriftProcessor
+  function GreeterProcessor()
+    p = new(ThriftProcessor())
+    handle(p.tp, __handler__greet_Greeter)
+    extend(p.tp, CounterProcessor().tp) # using Counter
+    p
+  end
+end # mutable struct GreeterProcessor
+_greet(inp::greet_args_Greeter, outp::greet_result_Greeter=greet_result_Greeter()) = (outp.success = greet(inp.name); outp)
+
+const __handler__greet_Greeter = ThriftHandler("greet", _greet, greet_args_Greeter, greet_result_Greeter)
+
+function process(p::GreeterProcessor, inp::TProtocol, outp::TProtocol, outlock::ReentrantLock...)
+  (name, typ, seqid) = Thrift.readMessageBegin(inp)
+  len = sizeof(name)
+  if len == 5
+    (name == "greet") && (return Thrift._process(p.tp, inp, outp, name, typ, seqid, __handler__greet_Greeter, outlock...))
+    (name == "twice") && (return Thrift._process(p.tp.extends, inp, outp, name, typ, seqid, __handler__twice_Counter, outlock...))
+  end
+  Thrift._unknown(inp, outp, name, seqid, outlock...)
+end
+distribute(p::GreeterProcessor) = distribute(p.tp)
+recycle(p::GreeterProcessor, use_pool::Bool=true) = recycle(p.tp, use_pool)
+instrument(p::GreeterProcessor, m::Union{Nothing,ThriftMetrics}=ThriftMetrics()) = instrument(p.tp, m)
+metrics(p::GreeterProcessor) = metrics(p.tp)
+
+
+# Server side methods to be defined by user:
+# function greet(name::String)
+#     # returns String
+
+
+# Client implementation for Greeter service
+mutable struct GreeterClient <: GreeterClientBase
+  p::TProtocol
+  seqid::Int32
+  GreeterClient(p::TProtocol) = new(p, 0)
+end # mutable struct GreeterClient
+
+# Client callable method for greet
+function greet(c::GreeterClientBase, name::String)
+  p = c.p
+  c.seqid = (c.seqid < (2^31-1)) ? (c.seqid+1) : 0
+  Thrift.writeMessageBegin(p, "greet", Thrift.MessageType.CALL, c.seqid)
+  inp = greet_args_Greeter()
+  inp.name = name
+  Thrift.write(p, inp)
+  Thrift.writeMessageEnd(p)
+  Thrift.flush(p.t)
+  
+  (fname, mtype, rseqid) = Thrift.readMessageBegin(p)
+  (mtype == Thrift.MessageType.EXCEPTION) && throw(Thrift.read(p, Thrift.TApplicationException()))
+  outp = Thrift.read(p, greet_result_Greeter())
+  Thrift.readMessageEnd(p)
+  (rseqid != c.seqid) && throw(Thrift.TApplicationException(; typ=ApplicationExceptionType.BAD_SEQUENCE_ID, message="response sequence id $rseqid did not match request ($(c.seqid))"))
+  hasproperty(outp, :success) && (return outp.success)
+  throw(Thrift.TApplicationException(; typ=Thrift.ApplicationExceptionType.MISSING_RESULT, message="retrieve failed: unknown result"))
+end # function greet
+
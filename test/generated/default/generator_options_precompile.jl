@@ -0,0 +1,37 @@
+#
+# Autogenerated by Thrift Compiler (0.12.1)
+#
+# DO NOT EDIT UNLESS YOU ARE SURE THAT YOU KNOW WHAT YOU ARE DOING
+
+function _precompile_()
+    (ccall(:jl_generating_output, Cint, ()) == 1) || return nothing
+    for P in (TBinaryProtocol, TCompactProtocol)
+        precompile(Thrift.read_container, (P, Record))
+        precompile(Thrift.write_container, (P, Record))
+        precompile(Thrift.read_container, (P, Defaults))
+        precompile(Thrift.write_container, (P, Defaults))
+        precompile(Thrift.read_container, (P, Leveled))
+        precompile(Thrift.write_container, (P, Leveled))
+        precompile(Thrift.read_container, (P, Nested))
+        precompile(Thrift.write_container, (P, Nested))
+        precompile(Thrift.read_container, (P, AllKinds))
+        precompile(Thrift.write_container, (P, AllKinds))
+        precompile(Thrift.read_container, (P, twice_args_Counter))
+        precompile(Thrift.write_container, (P, twice_args_Counter))
+        precompile(Thrift.read_container, (P, twice_result_Counter))
+        precompile(Thrift.write_container, (P, twice_result_Counter))
+        precompile(process, (CounterProcessor, P, P))
+        precompile(Thrift._process, (Thrift.ThriftProcessor, P, P, String, Int32, Int32, typeof(__handler__twice_Counter)))
+        precompile(Thrift.read_container, (P, greet_args_Greeter))
+        precompile(Thrift.write_container, (P, greet_args_Greeter))
+        precompile(Thrift.read_container, (P, greet_result_Greeter))
+        precompile(Thrift.write_container, (P, greet_result_Greeter))
+        precompile(process, (GreeterProcessor, P, P))
+        precompile(Thrift._process, (Thrift.ThriftProcessor, P, P, String, Int32, Int32, typeof(__handler__greet_Greeter)))
+    end
+    precompile(_twice, (twice_args_Counter, twice_result_Counter))
+    precompile(twice, (CounterClient, Int32))
+    precompile(_greet, (greet_args_Greeter, greet_result_Greeter))
+    precompile(greet, (GreeterClient, String))
+    nothing
+end
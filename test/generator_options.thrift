@@ -0,0 +1,52 @@
+struct Record {
+    1: required i32 id,
+    2: optional string label,
+    3: optional list<string> tags,
+    4: optional map<string,i64> counts
+}
+
+struct Defaults {
+    1: optional list<i32> nums = [1, 2],
+    2: optional map<string,i32> counts = {"a": 1},
+    3: optional i32 limit = 10
+}
+
+enum Level {
+    LOW = 1,
+    MINIMUM = 1,
+    HIGH = 2
+}
+
+struct Leveled {
+    1: optional Level level
+}
+
+struct Nested {
+    1: optional i32 num
+}
+
+struct AllKinds {
+    1: optional bool flag,
+    2: optional byte tiny,
+    3: optional i16 small,
+    4: optional i32 num,
+    5: optional i64 big,
+    6: optional double real,
+    7: optional string text,
+    8: optional binary blob,
+    9: optional list<i64> nums,
+    10: optional set<string> names,
+    11: optional map<string,binary> blobs,
+    12: optional list<Nested> nesteds,
+    13: optional Nested nested,
+    14: optional Level level,
+    16: optional list<binary> blob_list
+}
+
+service Counter {
+    i32 twice(1: i32 x)
+}
+
+service Greeter extends Counter {
+    string greet(1: string name)
+}
@@ -0,0 +1,338 @@
+module ThriftGeneratorTests
+
+# Tests of code generated with the generator options. The code generated from
+# `generator_options.thrift` by `compiler/t_jl_generator.cc` is checked in under `generated/`,
+# once with the default options and once with all options, so that it is tested without a
+# compiler. If a compiler built with the generator is passed in the `THRIFT_COMPILER`
+# environment variable, the checked in code is also verified to be what it generates now.
+# (The compiler that `Thrift.generate` runs does not have the options.)
+
+using Thrift
+using Test
+using Sockets
+
+const testdir = dirname(@__FILE__)
+const compiler = get(ENV, "THRIFT_COMPILER", "")
+
+# implementation of the services in `generator_options.thrift`
+const service_impl = """
+twice(x::Int32) = Int32(2x)
+greet(name::String) = "hello " * name
+"""
+
+# checked in code, by the options it was generated with
+const checked_in = Dict(""=>"default", "typed_fields,binary_views,async_client,typed_enums"=>"all_options")
+
+# generated files, without the line with the compiler version
+generated_lines(file::String) = filter(l->!startswith(l, "# Autogenerated by Thrift Compiler"), readlines(file))
+
+# verify that the checked in code is what the compiler generates with `options`
+function test_checked_in(options::String)
+    dir = mktempdir()
+    gen = isempty(options) ? "jl" : "jl:$options"
+    run(Cmd(`$compiler -gen $gen $(joinpath(testdir, "generator_options.thrift"))`; dir=dir))
+    gendir = joinpath(dir, "gen-jl", "generator_options")
+    srcdir = joinpath(testdir, "generated", checked_in[options])
+    @testset "checked in $(checked_in[options])" begin
+        @test sort(readdir(gendir)) == sort(readdir(srcdir))
+        for file in readdir(gendir)
+            @test generated_lines(joinpath(gendir, file)) == generated_lines(joinpath(srcdir, file))
+        end
+    end
+end
+
+# load the code generated with `options` into a module of its own
+function generated(options::String="")
+    dir = mktempdir()
+    srcdir = joinpath(testdir, "generated", checked_in[options])
+    for file in readdir(srcdir)
+        cp(joinpath(srcdir, file), joinpath(dir, file))
+    end
+    write(joinpath(dir, "generator_options_impl.jl"), service_impl)
+    wrapper = Module(Symbol("generated_", checked_in[options]))
+    Base.include(wrapper, joinpath(dir, "generator_options.jl"))
+    getfield(wrapper, :generator_options)
+end
+
+function allkinds(gen::Module)
+    gen.AllKinds(; flag=true, tiny=0x7f, small=Int16(-3), num=Int32(42), big=typemax(Int64), real=1.5,
+        text="text", blob=UInt8[0, 1, 2], nums=[1, -1, 2^40], names=Set(["a", "b"]), blobs=Dict("x"=>UInt8[3, 4]),
+        nesteds=[gen.Nested(; num=Int32(1)), gen.Nested(; num=Int32(2))], nested=gen.Nested(; num=Int32(3)),
+        level=gen.Level.HIGH, blob_list=[UInt8[5], UInt8[]])
+end
+
+function test_allkinds(val, gen::Module)
+    @test val.flag === true
+    @test val.tiny === 0x7f
+    @test val.small === Int16(-3)
+    @test val.num === Int32(42)
+    @test val.big === typemax(Int64)
+    @test val.real === 1.5
+    @test val.text == "text"
+    @test val.blob == UInt8[0, 1, 2]
+    @test val.nums == [1, -1, 2^40]
+    @test val.names == Set(["a", "b"])
+    @test val.blobs == Dict("x"=>UInt8[3, 4])
+    @test [n.num for n in val.nesteds] == [1, 2]
+    @test val.nested.num == 3
+    @test val.level == gen.Level.HIGH
+    @test val.blob_list == [UInt8[5], UInt8[]]
+end
+
+# bytes of `val` written by `writer`
+function written(writer, P::Type, val)
+    t = TMemoryTransport()
+    writer(P(t), val)
+    take!(t.buff)
+end
+
+function test_generated_readers_writers(gen::Module)
+    @testset "generated readers and writers" begin
+        # the generated methods, and the generic ones that go by the struct meta
+        @test which(Thrift.write_container, (TBinaryProtocol, gen.AllKinds)).module === gen
+        @test which(Thrift.read_container, (TBinaryProtocol, gen.AllKinds)).module === gen
+        generic_write(p, val) = invoke(Thrift.write_container, Tuple{TProtocol,Any}, p, val)
+        generic_read(p, val) = invoke(Thrift.read_container, Tuple{TProtocol,Any}, p, val)
+
+        val = allkinds(gen)
+        for P in (TBinaryProtocol, TCompactProtocol)
+            bytes = written(Thrift.write_container, P, val)
+            @test bytes == written(generic_write, P, val)
+
+            # either reads what either writes
+            for reader in (Thrift.read_container, generic_read)
+                test_allkinds(reader(P(TMemoryTransport(copy(bytes))), gen.AllKinds()), gen)
+            end
+
+            # unset fields are left out, and unknown fields skipped
+            partial = gen.AllKinds(; num=Int32(1), nested=gen.Nested())
+            pbytes = written(Thrift.write_container, P, partial)
+            @test pbytes == written(generic_write, P, partial)
+            rec = Thrift.read_container(P(TMemoryTransport(copy(pbytes))), gen.Record())
+            @test !hasproperty(rec, :id)
+            for reader in (Thrift.read_container, generic_read)
+                res = reader(P(TMemoryTransport(copy(pbytes))), gen.AllKinds())
+                @test res.num == 1
+                @test !hasproperty(res.nested, :num)
+                @test !hasproperty(res, :text)
+            end
+        end
+    end
+end
+
+function test_typed_fields(gen::Module)
+    @testset "typed_fields" begin
+        @test gen.Record <: Thrift.TTypedMsg
+        @test fieldtype(gen.Record, :tags) === Union{Nothing,Vector{String}}
+
+        rec = gen.Record(; id=1, label="one", tags=["a", "b"])
+        @test hasproperty(rec, :label)
+        @test !hasproperty(rec, :counts)
+        @test rec.id === Int32(1)
+        for P in (TBinaryProtocol, TCompactProtocol)
+            t = TMemoryTransport()
+            write(P(t), rec)
+            val = read(P(t), gen.Record)
+            @test val.id === Int32(1)
+            @test val.label == "one"
+            @test val.tags == ["a", "b"]
+            @test !hasproperty(val, :counts)
+        end
+
+        clear(rec)
+        @test !hasproperty(rec, :id)
+        @test_throws ErrorException write(TBinaryProtocol(TMemoryTransport()), rec)
+    end
+end
+
+function test_defaults(gen::Module)
+    @testset "struct defaults" begin
+        # set by the generated setter
+        @test which(Thrift.setdefaultproperties!, (gen.Defaults,)).module === gen
+
+        a = gen.Defaults()
+        b = gen.Defaults()
+        @test a.nums == Int32[1, 2]
+        @test a.counts == Dict("a"=>Int32(1))
+        @test a.limit == 10
+
+        # each instance gets containers of its own
+        @test a.nums !== b.nums
+        @test a.counts !== b.counts
+        push!(a.nums, 3)
+        a.counts["b"] = 2
+        @test b.nums == Int32[1, 2]
+        @test gen.Defaults().counts == Dict("a"=>Int32(1))
+
+        # also when read
+        clear(b)
+        t = TMemoryTransport()
+        p = TBinaryProtocol(t)
+        write(p, b)
+        write(p, b)
+        v1 = read(p, gen.Defaults)
+        v2 = read(p, gen.Defaults)
+        @test v1.nums == v2.nums == Int32[1, 2]
+        @test v1.nums !== v2.nums
+        @test v1.counts !== v2.counts
+    end
+end
+
+function test_typed_enums(gen::Module)
+    @testset "typed_enums" begin
+        @test gen.Level.T <: Enum
+        @test length(instances(gen.Level.T)) == 2
+        @test Int32(gen.Level.HIGH) == 2
+
+        # names with the same value are aliases of the first
+        @test gen.Level.MINIMUM === gen.Level.LOW
+        for P in (TBinaryProtocol, TCompactProtocol)
+            t = TMemoryTransport()
+            write(P(t), gen.Leveled(; level=gen.Level.MINIMUM))
+            @test read(P(t), gen.Leveled).level === gen.Level.LOW
+        end
+    end
+end
+
+# process a call of `name` with `processor`, returns the result struct or the exception sent
+function call_processor(processor, name::String, args, result_type::Type)
+    reqp = TBinaryProtocol(TMemoryTransport())
+    repp = TBinaryProtocol(TMemoryTransport())
+    writeMessageBegin(reqp, name, Thrift.MessageType.CALL, Int32(1))
+    write(reqp, args)
+    writeMessageEnd(reqp)
+    process(processor, reqp, repp)
+    (rname, mtype, seqid) = readMessageBegin(repp)
+    res = read(repp, (mtype == Thrift.MessageType.EXCEPTION) ? TApplicationException : result_type)
+    readMessageEnd(repp)
+    res
+end
+
+function test_dispatcher(gen::Module)
+    @testset "service dispatcher" begin
+        p = gen.GreeterProcessor()
+
+        # methods of the extended service run with the processor core of that service, and its settings
+        m = ThriftMetrics()
+        instrument(p.tp.extends, m)
+        @test call_processor(p, "twice", gen.twice_args_Counter(; x=Int32(21)), gen.twice_result_Counter).success == 42
+        @test call_processor(p, "greet", gen.greet_args_Greeter(; name="you"), gen.greet_result_Greeter).success == "hello you"
+        s = snapshot(m)
+        @test s.methods["twice"].requests == 1
+        @test !haskey(s.methods, "greet")
+        @test Thrift.metrics(p.tp) === nothing
+
+        # in pipelined mode too
+        outlock = ReentrantLock()
+        reqp = TBinaryProtocol(TMemoryTransport())
+        repp = TBinaryProtocol(TMemoryTransport())
+        writeMessageBegin(reqp, "twice", Thrift.MessageType.CALL, Int32(2))
+        write(reqp, gen.twice_args_Counter(; x=Int32(5)))
+        writeMessageEnd(reqp)
+        wait(process(p, reqp, repp, outlock))
+        @test readMessageBegin(repp)[1] == "twice"
+        @test read(repp, gen.twice_result_Counter).success == 10
+        readMessageEnd(repp)
+
+        # unknown methods are answered with an exception
+        res = call_processor(p, "unknown", gen.greet_args_Greeter(; name="you"), gen.greet_result_Greeter)
+        @test isa(res, TApplicationException)
+        @test res.typ == ApplicationExceptionType.UNKNOWN_METHOD
+    end
+end
+
+function test_binary_views(gen::Module)
+    @testset "binary_views" begin
+        @test fieldtype(gen.AllKinds, :blob) === Union{Nothing,TBinaryView}
+        @test fieldtype(gen.AllKinds, :blobs) === Union{Nothing,Dict{String,TBinaryView}}
+        @test fieldtype(gen.AllKinds, :blob_list) === Union{Nothing,Vector{TBinaryView}}
+        @test fieldtype(gen.AllKinds, :text) === Union{Nothing,String}
+
+        for P in (TBinaryProtocol, TCompactProtocol)
+            t = TFramedTransport(TMemoryTransport())
+            write(P(t), allkinds(gen))
+            flush(t)
+            val = read(P(t), gen.AllKinds)
+            test_allkinds(val, gen)
+
+            # views into the frame read, not copies
+            @test isa(val.blob, TBinaryView)
+            @test val.blob.data === val.blobs["x"].data === val.blob_list[1].data
+        end
+    end
+end
+
+function test_async_client(gen::Module)
+    @testset "async_client" begin
+        port, sock = listenany(ip"127.0.0.1", 19200)
+        close(sock)
+        framed = x->TFramedTransport(x)
+        srvr = TSimpleServer(TServerSocket("127.0.0.1", Int(port)), gen.GreeterProcessor(), framed, x->TBinaryProtocol(x), framed, x->TBinaryProtocol(x))
+        pipelined(srvr)
+        @async try
+            serve(srvr)
+        catch ex
+            isa(ex, Base.IOError) || @error("test server stopped", exception=ex)
+        end
+
+        local t
+        for attempt in 1:50
+            t = framed(TSocket("127.0.0.1", Int(port)))
+            try
+                open(t)
+                break
+            catch ex
+                (isa(ex, Base.IOError) && (attempt < 50)) || rethrow()
+                sleep(0.1)
+            end
+        end
+        c = gen.GreeterAsyncClient(TBinaryProtocol(t))
+        @test isa(c, gen.CounterAsyncClientBase)
+
+        # calls of the service and the one it extends, made concurrently over the one connection
+        calls = [Threads.@spawn(fetch(isodd(idx) ? gen.twice(c, Int32(idx)) : gen.greet(c, string(idx)))) for idx in 1:50]
+        @test [fetch(call) for call in calls] == [isodd(idx) ? 2idx : "hello $idx" for idx in 1:50]
+        @test c.conn.err === nothing
+
+        close(t)
+        close(srvr)
+    end
+end
+
+# the generated `_precompile_` only runs while precompiling, so its statements are evaluated here
+function test_precompile(gen::Module, options::String)
+    @testset "precompile statements" begin
+        file = joinpath(testdir, "generated", checked_in[options], "generator_options_precompile.jl")
+        stmts = [Meta.parse(line) for line in strip.(readlines(file)) if startswith(line, "precompile(")]
+        @test !isempty(stmts)
+        for P in (TBinaryProtocol, TCompactProtocol), stmt in stmts
+            @test Core.eval(gen, :(let P = $P; $stmt; end)) === true
+        end
+    end
+end
+
+@testset "generator options" begin
+    if isempty(compiler)
+        @info("THRIFT_COMPILER not set, not verifying the checked in generated code")
+    else
+        for options in keys(checked_in)
+            test_checked_in(options)
+        end
+    end
+
+    plain = generated()
+    Base.invokelatest(test_dispatcher, plain)
+    Base.invokelatest(test_defaults, plain)
+    Base.invokelatest(test_generated_readers_writers, plain)
+    test_precompile(plain, "")
+    typed = generated("typed_fields,binary_views,async_client,typed_enums")
+    Base.invokelatest(test_typed_fields, typed)
+    Base.invokelatest(test_defaults, typed)
+    Base.invokelatest(test_typed_enums, typed)
+    Base.invokelatest(test_generated_readers_writers, typed)
+    Base.invokelatest(test_binary_views, typed)
+    Base.invokelatest(test_async_client, typed)
+    test_precompile(typed, "typed_fields,binary_views,async_client,typed_enums")
+end
+
+end # module ThriftGeneratorTests
@@ -1,6 +1,15 @@
 using Thrift
 using Test
 
+# counts writes to the transport it wraps
+mutable struct CountingTransport <: Thrift.TTransport
+    tp::TMemoryTransport
+    nwrites::Int
+end
+Base.write(t::CountingTransport, buff::Vector{UInt8}) = (t.nwrites += 1; write(t.tp, buff))
+Base.read(t::CountingTransport, sz::Integer) = read(t.tp, sz)
+Base.flush(t::CountingTransport) = flush(t.tp)
+
 @testset "HeaderTransport" begin
 
     @testset "Write and read data" begin
@@ -37,6 +46,26 @@ using Test
         @test read(header_transport.rbuf) == bytes
     end
 
+    @testset "Send each message with one write" begin
+        memory_transport = TMemoryTransport()
+        counting_transport = CountingTransport(memory_transport, 0)
+        header_transport = THeaderTransport(counting_transport)
+        header_transport.min_transform_size = 100
+
+        for (transforms, nbytes) in ((Thrift.TransformIDEnum[], 100), ([Thrift.TransformID.ZLIB], 40), ([Thrift.TransformID.ZLIB], 400))
+            header_transport.write_transforms = transforms
+            bytes = rand(UInt8(1):UInt8(4), nbytes)
+            write(header_transport, bytes)
+            flush(header_transport)
+            @test counting_transport.nwrites == 1
+            @test bytesavailable(header_transport.wbuf) == 0
+            counting_transport.nwrites = 0
+
+            Thrift.read_frame!(header_transport)
+            @test read(header_transport.rbuf) == bytes
+        end
+    end
+
     @testset "Apply transformation" begin
         memory_transport = TMemoryTransport()
 
@@ -58,5 +87,35 @@ using Test
         @test header_transport.read_headers["client_metadata"] ==
             "{\"agent\":\"Julia THeaderTransport\"}"
         @test read(header_transport.rbuf) == bytes
+
+        # codecs are reused for later frames
+        codecs = copy(header_transport.codecs)
+        @test length(codecs) == 4
+        write(header_transport, bytes)
+        flush(header_transport)
+        Thrift.read_frame!(header_transport)
+        @test read(header_transport.rbuf) == bytes
+        @test all(k -> header_transport.codecs[k] === codecs[k], keys(codecs))
+    end
+
+    @testset "Skip transformation of small payloads" begin
+        memory_transport = TMemoryTransport()
+        header_transport = THeaderTransport(memory_transport)
+        header_transport.write_transforms = [Thrift.TransformID.ZLIB]
+        header_transport.min_transform_size = 100
+
+        bytes = rand(UInt8(1):UInt8(4), 40)
+        write(header_transport, bytes)
+        flush(header_transport)
+        Thrift.read_frame!(header_transport)
+        @test isempty(header_transport.read_transforms)
+        @test read(header_transport.rbuf) == bytes
+
+        bytes = rand(UInt8(1):UInt8(4), 400)
+        write(header_transport, bytes)
+        flush(header_transport)
+        Thrift.read_frame!(header_transport)
+        @test header_transport.read_transforms == [Thrift.TransformID.ZLIB]
+        @test read(header_transport.rbuf) == bytes
     end
 end
@@ -0,0 +1,58 @@
+module RecordIOTests
+
+using Thrift
+using Test
+
+function testrecordio()
+    @testset "record files" begin
+        msgs = ["message $i" for i in 1:1000]
+        for compression in (:none, :zlib, :zstd)
+            fname = tempname()
+            w = TRecordWriter(fname; compression=compression, blocksize=1024)
+            for msg in msgs
+                write(w, msg)
+            end
+            @test length(w) == length(msgs)
+            close(w)
+
+            r = TRecordReader(fname)
+            @test length(r) == length(msgs)
+            @test length(r.blockoffsets) > 1
+            @test read(r, String, 500) == msgs[500]
+            @test read(r, String, 1) == msgs[1]
+            @test [read(r, String, idx) for idx in 1:length(r)] == msgs
+            @test_throws BoundsError read(r, String, length(msgs)+1)
+            @test isopen(r)
+            close(r)
+
+            # the file contents are not referred to after close, and can not be read
+            @test !isopen(r)
+            @test isempty(r.data) && isempty(r.cacheddata)
+            @test_throws ErrorException read(r, String, 1)
+            @test_throws ErrorException r[1]
+            rm(fname)
+        end
+
+        # records of files without an index are located by scanning for sync markers
+        fname = tempname()
+        w = TRecordWriter(fname; index=false, blocksize=64)
+        for idx in 1:20
+            writerecord(w, fill(UInt8(idx), idx))
+        end
+        close(w)
+        open(fname, "a") do io
+            write(io, rand(UInt8, 10))  # an incomplete block at the end
+        end
+        r = TRecordReader(fname)
+        @test length(r) == 20
+        @test r[7] == fill(UInt8(7), 7)
+        @test isa(r[7], TBinaryView)
+        @test collect(r)[20] == fill(UInt8(20), 20)
+        close(r)
+        rm(fname)
+    end
+end
+
+testrecordio()
+
+end # module RecordIOTests
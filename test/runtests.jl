@@ -12,7 +12,11 @@ else
         @info("Running protocol and transport tests")
         include("memtransport_tests.jl")
         include("filetransport_tests.jl")
+        include("recordio_tests.jl")
         include("headertransport_tests.jl")
         include("utils_tests.jl")
+
+        @info("Running generator option tests")
+        include("generator_tests.jl")
     end
 end
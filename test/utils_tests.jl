@@ -4,6 +4,7 @@ using Thrift
 using Test
 import Thrift: meta
 using Base.Threads
+using Sockets
 
 struct _enum_TestEnum
     BOOLEAN::Int32
@@ -17,10 +18,42 @@ struct _enum_TestEnum
 end
 const TestEnum = _enum_TestEnum(Int32(0), Int32(1), Int32(2), Int32(3), Int32(4), Int32(5), Int32(6), Int32(7))
 
+baremodule TestTypedEnum
+import Base: @enum
+@enum T::Int32 begin
+    ONE = 1
+    TWO = 2
+end
+end # module TestTypedEnum
+
+struct _enum_TestSpawnedEnum
+    FIRST::Int32
+    SECOND::Int32
+end
+const TestSpawnedEnum = _enum_TestSpawnedEnum(Int32(1), Int32(2))
+
 function test_enum()
     @testset "enum" begin
         @test enumstr(TestEnum, TestEnum.BOOLEAN) == "BOOLEAN"
         @test_throws ErrorException enumstr(TestEnum, Int32(11))
+        @test Thrift.enumnames(TestEnum) === Thrift.enumnames(TestEnum)
+
+        # names looked up from many threads, while they are cached
+        lookups = [Threads.@spawn((enumstr(TestSpawnedEnum, Int32(2)), Thrift.enumnames(TestSpawnedEnum))) for idx in 1:20]
+        @test all(fetch(l)[1] == "SECOND" for l in lookups)
+        @test all(fetch(l)[2] === Thrift.enumnames(TestSpawnedEnum) for l in lookups)
+        @test Thrift.enumnames(TestEnum) === Thrift.enumnames(TestEnum)
+
+        # enums generated with typed_enums
+        @test enumstr(TestTypedEnum, TestTypedEnum.TWO) == "TWO"
+        @test Thrift.thrift_type(TestTypedEnum.T) == TType.I32
+        for P in (TBinaryProtocol, TCompactProtocol)
+            t = TMemoryTransport()
+            write(P(t), TestTypedEnum.TWO)
+            write(P(t), [TestTypedEnum.ONE, TestTypedEnum.TWO])
+            @test read(P(t), TestTypedEnum.T) === TestTypedEnum.TWO
+            @test read(P(t), Vector{TestTypedEnum.T}) == [TestTypedEnum.ONE, TestTypedEnum.TWO]
+        end
     end
 end
 
@@ -142,6 +175,217 @@ end
 
 meta(::Type{AllTypesDefault}) = __meta__AllTypesDefault
 
+mutable struct TestTypedAllTypes <: Thrift.TTypedMsg
+    meta::ThriftMeta
+    bool_val::Union{Nothing,Bool}
+    i32_val::Union{Nothing,Int32}
+    string_val::Union{Nothing,String}
+    list_val::Union{Nothing,Vector{Int16}}
+
+    function TestTypedAllTypes(; kwargs...)
+        obj = new(__meta__TestTypedAllTypes, nothing, nothing, nothing, nothing)
+        symdict = obj.meta.symdict
+        for nv in kwargs
+            fldname, fldval = nv
+            (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+            setproperty!(obj, fldname, fldval)
+        end
+        Thrift.setdefaultproperties!(obj)
+        obj
+    end
+end # mutable struct TestTypedAllTypes
+
+const __meta__TestTypedAllTypes = meta(TestTypedAllTypes,
+    Symbol[:bool_val,:i32_val,:string_val,:list_val],
+    Type[Bool,Int32,String,Vector{Int16}],
+    Symbol[:list_val],
+    Int[],
+    Dict{Symbol,Any}(:i32_val => Int32(20))
+)
+
+function Base.getproperty(obj::TestTypedAllTypes, name::Symbol)
+    if name === :bool_val
+        return (Thrift.fieldvalue(obj, :bool_val))::Bool
+    elseif name === :i32_val
+        return (Thrift.fieldvalue(obj, :i32_val))::Int32
+    elseif name === :string_val
+        return (Thrift.fieldvalue(obj, :string_val))::String
+    elseif name === :list_val
+        return (Thrift.fieldvalue(obj, :list_val))::Vector{Int16}
+    else
+        getfield(obj, name)
+    end
+end
+
+function Base.setproperty!(obj::TestTypedAllTypes, name::Symbol, val)
+    if name === :bool_val
+        setfield!(obj, :bool_val, isa(val, Bool) ? val : convert(Bool, val))
+    elseif name === :i32_val
+        setfield!(obj, :i32_val, isa(val, Int32) ? val : convert(Int32, val))
+    elseif name === :string_val
+        setfield!(obj, :string_val, isa(val, String) ? val : convert(String, val))
+    elseif name === :list_val
+        setfield!(obj, :list_val, isa(val, Vector{Int16}) ? val : convert(Vector{Int16}, val))
+    else
+        setfield!(obj, name, val)
+    end
+end
+
+meta(::Type{TestTypedAllTypes}) = __meta__TestTypedAllTypes
+
+function test_typed_meta()
+    @testset "typed fields" begin
+        types = TestTypedAllTypes(; bool_val=true)
+        @test hasproperty(types, :bool_val)
+        @test hasproperty(types, :i32_val)
+        @test types.i32_val === Int32(20)
+        @test !hasproperty(types, :string_val)
+        @test_throws KeyError types.string_val
+        @test !isfilled(types)
+
+        types.string_val = "hello"
+        @test isfilled(types)
+        types.i32_val = 10
+        @test types.i32_val === Int32(10)
+
+        clear(types, :bool_val)
+        @test !hasproperty(types, :bool_val)
+        types.bool_val = false
+        types.list_val = [1, 2, 3]
+
+        for P in (TBinaryProtocol, TCompactProtocol)
+            t = TMemoryTransport()
+            write(P(t), types)
+            types_read = read(P(t), TestTypedAllTypes)
+            for name in propertynames(types)
+                @test getproperty(types_read, name) == getproperty(types, name)
+            end
+        end
+
+        types2 = TestTypedAllTypes()
+        copy!(types2, types)
+        @test types2.list_val == Int16[1, 2, 3]
+        clear(types2)
+        @test !hasproperty(types2, :i32_val)
+    end
+end
+
+mutable struct TestMetaSubset <: Thrift.TMsg
+    meta::ThriftMeta
+    values::Dict{Symbol,Any}
+
+    function TestMetaSubset(; kwargs...)
+        obj = new(__meta__TestMetaSubset, Dict{Symbol,Any}())
+        values = obj.values
+        symdict = obj.meta.symdict
+        for nv in kwargs
+            fldname, fldval = nv
+            fldtype = symdict[fldname].jtype
+            (fldname in keys(symdict)) || error(string(typeof(obj), " has no field with name ", fldname))
+            values[fldname] = isa(fldval, fldtype) ? fldval : convert(fldtype, fldval)
+        end
+        Thrift.setdefaultproperties!(obj)
+        obj
+    end
+end # mutable struct TestMetaSubset
+
+const __meta__TestMetaSubset = meta(TestMetaSubset,
+    Symbol[:bool_val,:i32_val,:string_val],
+    Type[Bool,Int32,String],
+    Symbol[:bool_val],
+    Int[1,4,7],
+    Dict{Symbol,Any}()
+)
+
+function Base.getproperty(obj::TestMetaSubset, name::Symbol)
+    if name === :bool_val
+        return (obj.values[name])::Bool
+    elseif name === :i32_val
+        return (obj.values[name])::Int32
+    elseif name === :string_val
+        return (obj.values[name])::String
+    else
+        getfield(obj, name)
+    end
+end
+
+meta(::Type{TestMetaSubset}) = __meta__TestMetaSubset
+
+function Thrift.read_container(p::TProtocol, val::TestMetaSubset)
+    Thrift.readStructBegin(p)
+    clear(val)
+    while true
+        (name, ttyp, id) = Thrift.readFieldBegin(p)
+        (ttyp == Thrift.TType.STOP) && break
+        if (id == 1) && (ttyp == Thrift.TType.BOOL)
+            val.bool_val = Thrift.read(p, Bool)
+        elseif (id == 4) && (ttyp == Thrift.TType.I32)
+            val.i32_val = Thrift.read(p, Int32)
+        elseif (id == 7) && (ttyp == Thrift.TType.STRING)
+            val.string_val = Thrift.read(p, String)
+        else
+            Thrift.skip_value(p, ttyp)
+        end
+        Thrift.readFieldEnd(p)
+    end
+    Thrift.readStructEnd(p)
+    Thrift.setdefaultproperties!(val)
+end
+
+function Thrift.write_container(p::TProtocol, val::TestMetaSubset)
+    Thrift.writeStructBegin(p, "TestMetaSubset")
+    if hasproperty(val, :bool_val)
+        Thrift.writeFieldBegin(p, "bool_val", Thrift.TType.BOOL, 1)
+        Thrift.writeBool(p, val.bool_val)
+        Thrift.writeFieldEnd(p)
+    end
+    if hasproperty(val, :i32_val)
+        Thrift.writeFieldBegin(p, "i32_val", Thrift.TType.I32, 4)
+        Thrift.write(p, val.i32_val)
+        Thrift.writeFieldEnd(p)
+    else
+        error("required field i32_val not populated")
+    end
+    if hasproperty(val, :string_val)
+        Thrift.writeFieldBegin(p, "string_val", Thrift.TType.STRING, 7)
+        Thrift.write(p, val.string_val)
+        Thrift.writeFieldEnd(p)
+    else
+        error("required field string_val not populated")
+    end
+    Thrift.writeFieldStop(p)
+    Thrift.writeStructEnd(p)
+    nothing
+end
+
+function test_specialized_readwrite()
+    @testset "specialized read write" begin
+        types = TestMetaAllTypes(; bool_val=true, byte_val=1, i16_val=2, i32_val=3, i64_val=4, double_val=5.0, string_val="6")
+        for P in (TBinaryProtocol, TCompactProtocol)
+            # unknown fields are skipped by both the specialized and the meta driven readers
+            t = TMemoryTransport()
+            write(P(t), types)
+            subset = read(P(t), TestMetaSubset)
+            @test subset.bool_val === true
+            @test subset.i32_val === Int32(3)
+            @test subset.string_val == "6"
+
+            t = TMemoryTransport()
+            write(P(t), subset)
+            types_read = read(P(t), TestMetaAllTypes)
+            @test types_read.i32_val === Int32(3)
+            @test types_read.string_val == "6"
+            @test !hasproperty(types_read, :i64_val)
+
+            subset.bool_val = false
+            t = TMemoryTransport()
+            write(P(t), subset)
+            @test read(P(t), TestMetaSubset).bool_val === false
+        end
+        @test_throws ErrorException write(TBinaryProtocol(TMemoryTransport()), TestMetaSubset(; i32_val=1))
+    end
+end
+
 function test_meta()
     @testset "test metadata" begin
         @test !Thrift.isplain(TestMetaAllTypes)
@@ -172,6 +416,26 @@ function test_meta()
 
         types3 = AllTypesDefault()
         @test isfilled(types3)
+
+        # immutable defaults are shared, others are copied
+        types4 = AllTypesDefault()
+        @test types4.string_val === types3.string_val
+        @test types4.list_val == types3.list_val
+        @test types4.list_val !== types3.list_val
+        @test types4.map_val !== types3.map_val
+
+        # a container field repeated on the wire is read into the value already set
+        t = TMemoryTransport()
+        p = TBinaryProtocol(t)
+        writeStructBegin(p, "AllTypesDefault")
+        for vals in (Int16[1, 2], Int16[3])
+            writeFieldBegin(p, "list_val", TType.LIST, 9)
+            write(p, vals)
+            writeFieldEnd(p)
+        end
+        writeFieldStop(p)
+        writeStructEnd(p)
+        @test read(p, AllTypesDefault).list_val == Int16[1, 2, 3]
     end
 
     nothing
@@ -198,6 +462,109 @@ function test_parallel_readwrite()
     end
 end
 
+function test_read_all()
+    msgs = map(1:100) do idx
+        TestMetaAllTypes(; bool_val=isodd(idx), byte_val=1, i16_val=1, i32_val=idx, i64_val=1, double_val=1.1, string_val=string(idx))
+    end
+    for P in (TBinaryProtocol, TCompactProtocol)
+        t = TMemoryTransport()
+        for msg in msgs
+            write(P(t), msg)
+        end
+        bytes = take!(t.buff)
+        for nthreads in (1, 3, 200)
+            msgs_read = Thrift.read_all(TestMetaAllTypes, bytes; protocol=P, threads=nthreads)
+            @test length(msgs_read) == length(msgs)
+            @test [m.i32_val for m in msgs_read] == collect(1:100)
+            @test [m.string_val for m in msgs_read] == map(string, 1:100)
+        end
+    end
+    @test isempty(Thrift.read_all(TestMetaAllTypes, UInt8[]))
+end
+
+function test_metrics()
+    msg = TestMetaAllTypes(; bool_val=true, byte_val=1, i16_val=1, i32_val=1, i64_val=1, double_val=1.1, string_val="1")
+    reqt = TMemoryTransport()
+    reqp = TBinaryProtocol(reqt)
+    for seqid in 1:3
+        writeMessageBegin(reqp, "echo", Thrift.MessageType.CALL, seqid)
+        write(reqp, msg)
+        writeMessageEnd(reqp)
+    end
+    reqsz = bytesavailable(reqt.buff)
+
+    tp = ThriftProcessor()
+    handle(tp, ThriftHandler("echo", identity, TestMetaAllTypes, TestMetaAllTypes))
+    m = instrument(tp)
+    @test Thrift.metrics(tp) === m
+    inp = TBinaryProtocol(TMeteredTransport(reqt))
+    outt = TMeteredTransport(TMemoryTransport())
+    outp = TBinaryProtocol(outt)
+    for seqid in 1:3
+        process(tp, inp, outp)
+    end
+
+    s = snapshot(m)
+    mm = s.methods["echo"]
+    @test mm.requests == 3
+    @test mm.exceptions == 0
+    @test mm.bytes_in == reqsz
+    @test mm.bytes_out == outt.nwritten > 0
+    @test mm.decode.count == mm.handler.count == mm.encode.count == 3
+    @test sum(mm.handler.counts) == 3
+
+    io = IOBuffer()
+    write_prometheus(io, m)
+    text = String(take!(io))
+    @test occursin("thrift_requests_total{method=\"echo\"} 3", text)
+    @test occursin("thrift_latency_seconds_count{method=\"echo\",stage=\"decode\"} 3", text)
+
+    instrument(tp, nothing)
+    @test Thrift.metrics(tp) === nothing
+
+    # buckets include their upper bound, as Prometheus `le` buckets do
+    h = Thrift.LatencyHistogram()
+    for ns in (0, 1000, 1001, 2000, 2001, 4000)
+        Thrift.observe!(h, UInt64(ns))
+    end
+    @test h.counts[1:4] == [2, 2, 2, 0]
+end
+
+function test_partial_read()
+    msg = AllTypesDefault(; bool_val=false, i32_val=5, string_val="partial", map_val=Dict(Int32(3) => Int16(30)), list_val=Int16[7, 8], set_val=Set{UInt8}([9]))
+    for P in (TBinaryProtocol, TCompactProtocol)
+        t = TMemoryTransport()
+        write(P(t), msg)
+        write(P(t), msg)
+
+        # projected
+        val = read(P(t), AllTypesDefault; fields=(:i32_val, :list_val))
+        @test val.i32_val == 5
+        @test val.list_val == Int16[7, 8]
+        @test !hasproperty(val, :string_val)
+        @test !hasproperty(val, :map_val)
+
+        # lazy
+        lval = read(P(t), AllTypesDefault; lazy=true)
+        @test isa(lval, TLazyStruct)
+        @test bytesavailable(t.buff) == 0
+        @test lval.bool_val == false
+        @test hasproperty(lval, :string_val)
+        @test lval.string_val == "partial"
+        @test lval.map_val == Dict(Int32(3) => Int16(30))
+        @test lval.byte_val == 1     # default
+
+        # lazy structs are written out as they were read
+        write(P(t), lval)
+        val = read(P(t), AllTypesDefault)
+        for name in propertynames(msg)
+            @test getproperty(val, name) == getproperty(msg, name)
+        end
+        val = materialize(lval)
+        @test val.set_val == Set{UInt8}([9])
+    end
+end
+
 function test_zigzag()
     testcases = [
         0 => (nbytes=1, encval=0),
@@ -220,11 +587,601 @@ function test_zigzag()
     end
 end
 
+function test_varint()
+    vals = (0, 1, 127, 128, 16383, 16384, typemax(Int32), typemax(Int64))
+    for io in (PipeBuffer(), TMemoryTransport(), Base.BufferStream())
+        for v in vals
+            Thrift._write_uleb(io, v)
+        end
+        for v in vals
+            @test Thrift._read_uleb(io, Int64) === v
+        end
+    end
+
+    # varint split across frames is continued from the next frame
+    frames = UInt8[0x00, 0x00, 0x00, 0x02, 0x80, 0x80, 0x00, 0x00, 0x00, 0x01, 0x01]
+    t = TFramedTransport(TMemoryTransport(frames))
+    @test Thrift._read_uleb(t, Int32) === Int32(16384)
+end
+
+function test_bulk_lists()
+    lists = (Int16[-3, 0, 300], Int32[typemin(Int32), -1, 0, 1, typemax(Int32)], Int64[typemin(Int64), 5, typemax(Int64)], Float64[-1.5, 0.0, 3.25e10])
+    # the compact protocol expects collections to appear as values within a struct
+    compact(t, state) = (p = TCompactProtocol(t); p.state = state; p)
+    for l in lists
+        t = TMemoryTransport()
+        write(TBinaryProtocol(t), l)
+        @test read(TBinaryProtocol(t), typeof(l)) == l
+
+        write(compact(t, Thrift.CState.VALUE_WRITE), l)
+        @test read(compact(t, Thrift.CState.VALUE_READ), typeof(l)) == l
+    end
+
+    # compact varints beyond the buffered bytes are read from the next frame
+    mt = TMemoryTransport()
+    write(compact(mt, Thrift.CState.VALUE_WRITE), Int32[1, 1000, 100000])
+    bytes = take!(mt.buff)
+    nfirst = length(bytes) - 2
+    frames = UInt8[]
+    for part in (bytes[1:nfirst], bytes[(nfirst+1):end])
+        append!(frames, reinterpret(UInt8, [hton(UInt32(length(part)))]))
+        append!(frames, part)
+    end
+    @test read(compact(TFramedTransport(TMemoryTransport(frames)), Thrift.CState.VALUE_READ), Vector{Int32}) == Int32[1, 1000, 100000]
+end
+
+function test_serialized_size()
+    msgs = (AllTypesDefault(),
+        AllTypesDefault(; i16_val=-300, i64_val=typemin(Int64), string_val="", map_val=Dict{Int32,Int16}(), list_val=Int16.(-20:20), set_val=Set{UInt8}(1:20)),
+        TestMetaAllTypes(; bool_val=false, byte_val=1, i16_val=1, i32_val=-1, i64_val=1, double_val=1.1, string_val="one"))
+    for P in (TBinaryProtocol, TCompactProtocol), msg in msgs
+        t = TMemoryTransport()
+        p = P(t)
+        write(p, msg)
+        @test Thrift.serialized_size(P, msg) == bytesavailable(t.buff)
+
+        # room is made for the message header too
+        p = P(TMemoryTransport())
+        writeMessageBegin(p, "reply", Thrift.MessageType.REPLY, Int32(300))
+        @test Thrift.message_begin_size(p, "reply", Int32(300)) == bytesavailable(p.t.buff)
+        t = TFramedTransport(TMemoryTransport())
+        Thrift.reserve!(P(t), "reply", Int32(300), msg)
+        @test t.wcapacity == 4 + bytesavailable(p.t.buff) + Thrift.serialized_size(P, msg)
+    end
+
+    # values are sized only for transports that can reserve room, before anything is written into the frame
+    @test !Thrift.wants_reserve(TMemoryTransport())
+    @test !Thrift.wants_reserve(THeaderTransport(TMemoryTransport()))
+    @test !Thrift.wants_reserve(TBufferedTransport(TMemoryTransport()))
+    t = TFramedTransport(TMemoryTransport())
+    @test Thrift.wants_reserve(t)
+    write(t, UInt8[1])
+    @test !Thrift.wants_reserve(t)
+
+    # a frame is started in a larger array only when the array of the last frame sent is too small
+    t = TFramedTransport(TMemoryTransport())
+    write(t, zeros(UInt8, 100))
+    flush(t)
+    @test t.wcapacity == 104
+    Thrift.reserve!(t, 50)
+    @test t.wcapacity == 104
+    Thrift.reserve!(t, 200)
+    @test t.wcapacity == 204
+    write(t, UInt8[1, 2])
+    Thrift.reserve!(t, 300)
+    @test t.wcapacity == 204
+    flush(t)
+    @test take!(t.tp.buff)[(end-5):end] == UInt8[0x00, 0x00, 0x00, 0x02, 0x01, 0x02]
+end
+
+function test_binary_view()
+    blob = rand(UInt8, 1024)
+    for P in (TBinaryProtocol, TCompactProtocol)
+        t = TMemoryTransport()
+        write(P(t), blob, true)
+        write(P(t), TBinaryView(blob), true)
+        v1 = read(P(t), TBinaryView)
+        v2 = read(P(t), TBinaryView)
+        @test v1 == v2 == blob
+    end
+
+    # views into an earlier frame are not affected by reading later frames
+    frames = UInt8[]
+    for part in (UInt8[0x00, 0x00, 0x00, 0x02, 0x41, 0x42], UInt8[0x00, 0x00, 0x00, 0x02, 0x43, 0x44])
+        append!(frames, reinterpret(UInt8, [hton(UInt32(length(part)))]))
+        append!(frames, part)
+    end
+    p = TBinaryProtocol(TFramedTransport(TMemoryTransport(frames)))
+    v1 = read(p, TBinaryView)
+    @test v1.data === p.t.rframe
+    v2 = read(p, TBinaryView)
+    @test v1.data !== v2.data
+    @test String(copy(v1)) == "AB"
+    @test String(copy(v2)) == "CD"
+    @test Thrift.thrift_type(TBinaryView) == TType.STRING
+end
+
+function test_framed()
+    mt = TMemoryTransport()
+    t = TFramedTransport(mt)
+    write(t, UInt8[0x41, 0x42, 0x43])
+    flush(t)
+    @test take!(mt.buff) == UInt8[0x00, 0x00, 0x00, 0x03, 0x41, 0x42, 0x43]
+    write(t, UInt8[0x44])
+    flush(t)
+    write(t, UInt8[0x45, 0x46])
+    flush(t)
+
+    # frames are read into the same array once it is consumed
+    @test read(t, 1) == UInt8[0x44]
+    rframe = t.rframe
+    @test read(t, 2) == UInt8[0x45, 0x46]
+    @test t.rframe === rframe
+
+    # and written from the array of the last frame sent
+    write(t, UInt8[0x47])
+    flush(t)
+    @test take!(mt.buff) == UInt8[0x00, 0x00, 0x00, 0x01, 0x47]
+    write(t, UInt8[0x48, 0x49])
+    flush(t)
+    @test take!(mt.buff) == UInt8[0x00, 0x00, 0x00, 0x02, 0x48, 0x49]
+end
+
+function test_buffered()
+    mt = TMemoryTransport()
+    t = TBufferedTransport(mt; wbuffsize=8)
+    write(t, 0x01)
+    write(t, UInt32(2))
+    @test bytesavailable(mt.buff) == 0
+    write(t, UInt8[3, 4, 5, 6])
+    @test bytesavailable(mt.buff) == 5
+    flush(t)
+    @test bytesavailable(mt.buff) == 9
+    @test read(t, UInt8) == 0x01
+    @test bytesavailable(mt.buff) == 0
+    @test read(t, UInt32) == UInt32(2)
+    @test read(t, 4) == UInt8[3, 4, 5, 6]
+
+    # replies are held back while a request is readable, and sent before waiting for more
+    mt = TMemoryTransport(UInt8[1, 2])
+    t = TBufferedTransport(mt; coalesce=true)
+    write(t, UInt8[0x0a])
+    flush(t)
+    @test bytesavailable(mt.buff) == 2
+    @test read(t, 2) == UInt8[1, 2]
+    flush(t)
+    @test read(mt.buff) == UInt8[0x0a]
+end
+
+function test_skip()
+    msg = AllTypesDefault(; bool_val=false, i32_val=5, string_val="skipped", map_val=Dict(Int32(3) => Int16(30)), list_val=Int16[7, 8], set_val=Set{UInt8}([9]))
+    for P in (TBinaryProtocol, TCompactProtocol), T in (identity, TFramedTransport, TBufferedTransport)
+        mt = TMemoryTransport()
+        t = T(mt)
+        for idx in 1:2
+            write(P(t), msg)
+            flush(t)
+        end
+        skip(P(t), AllTypesDefault)
+        val = read(P(t), AllTypesDefault)
+        for name in propertynames(msg)
+            @test getproperty(val, name) == getproperty(msg, name)
+        end
+        @test bytesavailable(mt.buff) == 0
+    end
+
+    # skips span frames
+    mt = TMemoryTransport()
+    t = TFramedTransport(mt)
+    write(t, UInt8[1, 2, 3])
+    flush(t)
+    write(t, UInt8[4, 5, 6])
+    flush(t)
+    skip(t, 4)
+    @test read(t, 2) == UInt8[5, 6]
+    t = TMemoryTransport(UInt8[1, 2])
+    @test_throws EOFError skip(t, 3)
+end
+
+function test_fixed()
+    for io in (PipeBuffer(), TMemoryTransport())
+        Thrift._write_fixed(io, 0x0102, true)
+        Thrift._write_fixed(io, 0x01020304, true)
+        Thrift._write_fixed(io, 0x0102030405060708, false)
+        @test Thrift._read_fixed(io, UInt8, true) === 0x01
+        @test Thrift._read_fixed(io, UInt8, true) === 0x02
+        @test Thrift._read_fixed(io, UInt16, true) === 0x0102
+        @test Thrift._read_fixed(io, UInt16, false) === 0x0403
+        @test Thrift._read_fixed(io, UInt64, false) === 0x0102030405060708
+    end
+end
+
+##
+# A service with a method `echo`, that returns its argument after sleeping for `double_val` seconds,
+# and a oneway method `notify`. Its processor is put together here the way generated code does it,
+# to test servers and clients over a loopback socket.
+
+echo_msg(idx::Integer, delay::Real=0.0, str::String=string(idx)) = TestMetaAllTypes(; bool_val=true, byte_val=1, i16_val=1, i32_val=idx, i64_val=1, double_val=delay, string_val=str)
+
+# replies after waiting for `double_val` seconds, busy without yielding if it is negative
+function echo_handler(args::TestMetaAllTypes, res::TestMetaAllTypes=TestMetaAllTypes())
+    if args.double_val < 0
+        t0 = time()
+        while (time() - t0) < -args.double_val
+        end
+    else
+        sleep(args.double_val)
+    end
+    copy!(res, args)
+    res
+end
+
+const notified = Channel{Int32}(32)
+notify_handler(args::TestMetaAllTypes) = (put!(notified, args.i32_val); nothing)
+
+mutable struct EchoProcessor <: TProcessor
+    tp::ThriftProcessor
+    function EchoProcessor()
+        tp = ThriftProcessor()
+        handle(tp, ThriftHandler("echo", echo_handler, TestMetaAllTypes, TestMetaAllTypes))
+        handle(tp, ThriftHandler("notify", notify_handler, TestMetaAllTypes, Nothing))
+        new(tp)
+    end
+end
+Thrift.process(p::EchoProcessor, inp::TProtocol, outp::TProtocol) = process(p.tp, inp, outp)
+Thrift.process(p::EchoProcessor, inp::TProtocol, outp::TProtocol, outlock::ReentrantLock) = process(p.tp, inp, outp, outlock)
+Thrift.metrics(p::EchoProcessor) = Thrift.metrics(p.tp)
+
+framed_server(srvr_t, processor=EchoProcessor()) = TSimpleServer(srvr_t, processor, x->TFramedTransport(x), x->TBinaryProtocol(x), x->TFramedTransport(x), x->TBinaryProtocol(x))
+
+# serve on a free port with the server made by `mkserver`, returns the server and the port
+function start_server(mkserver)
+    port, sock = listenany(ip"127.0.0.1", 19100)
+    close(sock)
+    srvr = mkserver(TServerSocket("127.0.0.1", Int(port)))
+    @async try
+        serve(srvr)
+    catch ex
+        isa(ex, Base.IOError) || @error("test server stopped", exception=ex)
+    end
+    srvr, Int(port)
+end
+
+function connect_server(port::Int, transport=x->TFramedTransport(x), protocol=TBinaryProtocol)
+    for attempt in 1:50
+        try
+            t = transport(TSocket("127.0.0.1", port))
+            open(t)
+            return protocol(t)
+        catch ex
+            isa(ex, Base.IOError) || rethrow()
+            sleep(0.1)
+        end
+    end
+    error("could not connect to test server on port $port")
+end
+
+# a blocking call of echo
+function echo(p::TProtocol, msg::TestMetaAllTypes)
+    writeMessageBegin(p, "echo", Thrift.MessageType.CALL, Int32(1))
+    write(p, msg)
+    writeMessageEnd(p)
+    flush(p.t)
+    (name, mtype, seqid) = readMessageBegin(p)
+    res = read(p, TestMetaAllTypes)
+    readMessageEnd(p)
+    res
+end
+
+function test_async_connection()
+    srvr, port = start_server(framed_server)
+    p = connect_server(port)
+    conn = ThriftAsyncConnection(p)
+
+    # calls made one after another without waiting are matched to their replies
+    chs = [Thrift.call(conn, "echo", Thrift.MessageType.CALL, echo_msg(idx), TestMetaAllTypes()) for idx in 1:10]
+    @test [Thrift.reply(ch).i32_val for ch in chs] == collect(1:10)
+    @test Thrift.call(conn, "notify", Thrift.MessageType.ONEWAY, echo_msg(11), nothing) === nothing
+    @test take!(notified) == 11
+
+    # exceptions sent by the server are thrown, and leave the connection usable
+    ch = Thrift.call(conn, "unknown", Thrift.MessageType.CALL, echo_msg(12), TestMetaAllTypes())
+    @test_throws TApplicationException Thrift.reply(ch)
+    @test echo(p, echo_msg(13)).i32_val == 13
+
+    # failing to send a request fails the connection and closes its transport
+    close(p.t)
+    @test_throws Exception Thrift.call(conn, "echo", Thrift.MessageType.CALL, echo_msg(14), TestMetaAllTypes())
+    @test conn.err !== nothing
+    @test !isopen(p.t)
+    @test_throws typeof(conn.err) Thrift.call(conn, "echo", Thrift.MessageType.CALL, echo_msg(15), TestMetaAllTypes())
+
+    close(srvr)
+end
+
+function test_async_connection_compact()
+    # the compact protocol keeps state while in a message, so requests are written with a protocol of their own
+    # while replies are read, here from tasks on any thread over an unframed socket where the reader waits for
+    # the rest of each large reply
+    unframed = x->x
+    srvr, port = start_server(srvr_t->TSimpleServer(srvr_t, EchoProcessor(), unframed, x->TCompactProtocol(x), unframed, x->TCompactProtocol(x)))
+    p = connect_server(port, unframed, TCompactProtocol)
+    conn = ThriftAsyncConnection(p)
+    @test conn.inp === p
+    @test isa(conn.outp, TCompactProtocol) && (conn.outp !== p) && (conn.outp.t === p.t)
+
+    str(idx) = repeat(string(idx), 100_000)
+    calls = [Threads.@spawn(Thrift.reply(Thrift.call(conn, "echo", Thrift.MessageType.CALL, echo_msg(idx, 0.0, str(idx)), TestMetaAllTypes()))) for idx in 1:20]
+    @test [fetch(c).string_val for c in calls] == [str(idx) for idx in 1:20]
+    @test conn.err === nothing
+
+    close(p.t)
+    close(srvr)
+end
+
+function test_coalescing_server()
+    coalescing = x->TBufferedTransport(x; coalesce=true)
+    srvr, port = start_server(srvr_t->TSimpleServer(srvr_t, EchoProcessor(), coalescing, x->TBinaryProtocol(x), coalescing, x->TBinaryProtocol(x)))
+    p = connect_server(port, x->TBufferedTransport(x))
+
+    function request(name, mtype, msg)
+        reqp = TBinaryProtocol(TMemoryTransport())
+        writeMessageBegin(reqp, name, mtype, Int32(1))
+        write(reqp, msg)
+        writeMessageEnd(reqp)
+        take!(reqp.t.buff)
+    end
+    function read_reply()
+        t = @async begin
+            readMessageBegin(p)
+            res = read(p, TestMetaAllTypes)
+            readMessageEnd(p)
+            res.i32_val
+        end
+        (timedwait(()->istaskdone(t), 10.0) === :ok) ? fetch(t) : nothing
+    end
+
+    # the server reads and writes with separate transports, a reply held back because a oneway call
+    # arrived while it was being handled is sent before the server waits for more requests
+    write(p.t, request("echo", Thrift.MessageType.CALL, echo_msg(1, 0.2)))
+    flush(p.t)
+    write(p.t, request("notify", Thrift.MessageType.ONEWAY, echo_msg(2)))
+    flush(p.t)
+    @test read_reply() == 1
+    @test take!(notified) == 2
+
+    # and so is one held back because part of the next request arrived
+    req = request("echo", Thrift.MessageType.CALL, echo_msg(4))
+    write(p.t, request("echo", Thrift.MessageType.CALL, echo_msg(3, 0.2)))
+    flush(p.t)
+    write(p.t, req[1:10])
+    flush(p.t)
+    @test read_reply() == 3
+    write(p.t, req[11:end])
+    flush(p.t)
+    @test read_reply() == 4
+
+    close(p.t)
+    close(srvr)
+end
+
+function test_recycle()
+    p = EchoProcessor()
+    recycle(p.tp)
+    handler = p.tp.handlers["echo"]
+    reqp = TBinaryProtocol(TMemoryTransport())
+    repp = TBinaryProtocol(TMemoryTransport())
+
+    # messages are returned to the pools after each reply, and reused by the next request
+    instructs = Set{Any}()
+    for idx in 1:3
+        writeMessageBegin(reqp, "echo", Thrift.MessageType.CALL, Int32(idx))
+        write(reqp, echo_msg(idx))
+        writeMessageEnd(reqp)
+        process(p, reqp, repp)
+        @test length(handler.inpool.free) == 1
+        @test length(handler.outpool.free) == 1
+        push!(instructs, handler.inpool.free[1])
+
+        (name, mtype, seqid) = readMessageBegin(repp)
+        @test (name, mtype, seqid) == ("echo", Thrift.MessageType.REPLY, Int32(idx))
+        res = read(repp, TestMetaAllTypes)
+        readMessageEnd(repp)
+        @test res.i32_val == idx
+        @test res.string_val == string(idx)
+    end
+    @test length(instructs) == 1
+    @test !hasproperty(first(instructs), :i32_val)
+
+    # and allocated afresh when not recycling
+    recycle(p.tp, false)
+    writeMessageBegin(reqp, "echo", Thrift.MessageType.CALL, Int32(4))
+    write(reqp, echo_msg(4))
+    writeMessageEnd(reqp)
+    process(p, reqp, repp)
+    readMessageBegin(repp)
+    @test read(repp, TestMetaAllTypes).i32_val == 4
+    readMessageEnd(repp)
+    @test length(handler.inpool.free) == 1
+    nothing
+end
+
+# size of a framed binary request
+function request_size(name::String, mtype::Int32, msg)
+    p = TBinaryProtocol(TMemoryTransport())
+    writeMessageBegin(p, name, mtype, Int32(0))
+    write(p, msg)
+    writeMessageEnd(p)
+    4 + bytesavailable(p.t.buff)
+end
+
+function test_pipelined_server()
+    processor = EchoProcessor()
+    m = instrument(processor.tp)
+    srvr, port = start_server(srvr_t->(s = framed_server(srvr_t, processor); pipelined(s); s))
+    conn = ThriftAsyncConnection(connect_server(port))
+
+    # the reply to a quick call is not held up by a slow call made before it
+    slow = Thrift.call(conn, "echo", Thrift.MessageType.CALL, echo_msg(1, 2.0), TestMetaAllTypes())
+    fast = Thrift.call(conn, "echo", Thrift.MessageType.CALL, echo_msg(2), TestMetaAllTypes())
+    @test Thrift.reply(fast).i32_val == 2
+    @test !isready(slow)
+    @test Thrift.reply(slow).i32_val == 1
+
+    # oneway calls in between do not disturb the replies
+    chs = [Thrift.call(conn, "echo", Thrift.MessageType.CALL, echo_msg(idx, 0.1*(4-idx)), TestMetaAllTypes()) for idx in 1:3]
+    @test Thrift.call(conn, "notify", Thrift.MessageType.ONEWAY, echo_msg(4), nothing) === nothing
+    @test take!(notified) == 4
+    @test [Thrift.reply(ch).i32_val for ch in chs] == collect(1:3)
+
+    # nor by a slow call that keeps its thread busy, when there are threads to run it on
+    if Threads.nthreads() > 1
+        slow = Thrift.call(conn, "echo", Thrift.MessageType.CALL, echo_msg(5, -2.0), TestMetaAllTypes())
+        fast = Thrift.call(conn, "echo", Thrift.MessageType.CALL, echo_msg(6), TestMetaAllTypes())
+        @test Thrift.reply(fast).i32_val == 6
+        @test !isready(slow)
+        @test Thrift.reply(slow).i32_val == 5
+    end
+    nrequests = (Threads.nthreads() > 1) ? 7 : 5
+
+    # bytes received are counted against the method of each request, though replies are out of order
+    @test timedwait(()->(snapshot(m).methods["echo"].requests == nrequests), 10.0) === :ok
+    s = snapshot(m)
+    @test s.methods["echo"].bytes_in == nrequests * request_size("echo", Thrift.MessageType.CALL, echo_msg(1))
+    @test s.methods["notify"].bytes_in == request_size("notify", Thrift.MessageType.ONEWAY, echo_msg(4))
+
+    close(conn.inp.t)
+    close(srvr)
+end
+
+function test_thread_pool_server()
+    srvr, port = start_server(srvr_t->TThreadPoolServer(srvr_t, EchoProcessor(), x->TFramedTransport(x), x->TBinaryProtocol(x), x->TFramedTransport(x), x->TBinaryProtocol(x); nworkers=1))
+    clients = [connect_server(port) for idx in 1:3]
+
+    # persistent connections beyond the number of workers are all served
+    t = @async [echo(p, echo_msg(idx)).i32_val for round in 1:3 for (idx, p) in enumerate(clients)]
+    @test timedwait(()->istaskdone(t), 30.0) === :ok
+    istaskdone(t) && @test fetch(t) == repeat(1:3, 3)
+
+    # and concurrently
+    tasks = [@async([echo(p, echo_msg(idx, 0.01)).i32_val for round in 1:5]) for (idx, p) in enumerate(clients)]
+    @test timedwait(()->all(istaskdone, tasks), 30.0) === :ok
+    all(istaskdone, tasks) && @test [fetch(t) for t in tasks] == [fill(idx, 5) for idx in 1:3]
+
+    for p in clients
+        close(p.t)
+    end
+    close(srvr)
+
+    # accepting connections waits while the queue is full, till a worker takes a job
+    q = Thrift.ThreadPoolQueue(1)
+    Thrift._wait_capacity(q)
+    Thrift._queued!(q, 1)
+    waiter = @async Thrift._wait_capacity(q)
+    sleep(0.2)
+    @test !istaskdone(waiter)
+    Thrift._queued!(q, -1)
+    @test timedwait(()->istaskdone(waiter), 5.0) === :ok
+end
+
+function test_client_pool()
+    servers = [Sockets.listenany(ip"127.0.0.1", 19000) for idx in 1:2]
+    accepted = [TCPSocket[] for idx in 1:2]
+    for idx in 1:2
+        @async try
+            while true
+                push!(accepted[idx], accept(servers[idx][2]))
+            end
+        catch
+        end
+    end
+
+    pool = ThriftClientPool(TBinaryProtocol, [("127.0.0.1", Int(servers[idx][1])) for idx in 1:2]; size=2, protocol=identity, reconnect_delay=0.1)
+    @test length.(pool.idle) == [2, 2]
+
+    # connections are handed out from the endpoint with the least handed out
+    clients = Any[]
+    withclient(pool) do c1
+        push!(clients, c1)
+        withclient(pool) do c2
+            push!(clients, c2)
+            @test pool.outstanding == [1, 1]
+        end
+    end
+    @test clients[1] !== clients[2]
+    @test clients[1].t !== clients[2].t
+    @test pool.outstanding == [0, 0]
+    @test length.(pool.idle) == [2, 2]
+
+    # declared exceptions keep the connection, other errors replace it
+    @test_throws TApplicationException withclient(c->throw(TApplicationException(; typ=ApplicationExceptionType.UNKNOWN, message="")), pool)
+    @test sum(length.(pool.idle)) == 4
+    @test_throws EOFError withclient(c->throw(EOFError()), pool)
+    @test sum(length.(pool.idle)) == 3
+    @test timedwait(()->(sum(length.(pool.idle)) == 4), 5.0) === :ok
+
+    # so do application exceptions raised by the client, as the reply may not have been read in full
+    @test_throws TApplicationException withclient(c->throw(TApplicationException(; typ=ApplicationExceptionType.MISSING_RESULT, message="")), pool)
+    @test sum(length.(pool.idle)) == 3
+    @test timedwait(()->(sum(length.(pool.idle)) == 4), 5.0) === :ok
+
+    close(pool)
+    @test_throws TTransportException withclient(identity, pool)
+
+    # waiting for a connection times out
+    pool = ThriftClientPool(TBinaryProtocol, [("127.0.0.1", Int(servers[1][1]))]; size=1, protocol=identity, acquire_timeout=0.5)
+    ex = try
+        withclient(c->withclient(identity, pool), pool)
+        nothing
+    catch ex
+        ex
+    end
+    @test isa(ex, TTransportException) && (ex.typ == Thrift.TransportExceptionTypes.TIMED_OUT)
+    @test sum(length.(pool.idle)) == 1
+    close(pool)
+
+    # and fails right away when no endpoint can be connected to
+    port, server = Sockets.listenany(ip"127.0.0.1", 19200)
+    close(server)
+    pool = ThriftClientPool(TBinaryProtocol, [("127.0.0.1", Int(port))]; size=1, protocol=identity, reconnect_delay=10.0)
+    ex = try
+        withclient(identity, pool)
+        nothing
+    catch ex
+        ex
+    end
+    @test isa(ex, TTransportException) && (ex.typ == Thrift.TransportExceptionTypes.NOT_OPEN)
+    close(pool)
+
+    for (port, server) in servers
+        close(server)
+    end
+end
+
 @testset "utility functions" begin
     test_enum()
     test_container_check()
     test_meta()
+    test_typed_meta()
+    test_specialized_readwrite()
     test_zigzag()
+    test_fixed()
+    test_framed()
+    test_buffered()
+    test_skip()
+    test_varint()
+    test_bulk_lists()
+    test_binary_view()
+    test_serialized_size()
+    test_metrics()
+    test_partial_read()
+    test_recycle()
+    test_coalescing_server()
+    test_async_connection()
+    test_async_connection_compact()
+    test_pipelined_server()
+    test_thread_pool_server()
+    test_client_pool()
 end
 
 @testset "parallel read write" begin
@@ -237,6 +1194,8 @@ end
             @async test_parallel_readwrite()
         end
     end
+
+    test_read_all()
 end
 
 end